@@ -0,0 +1,176 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "AdjacencyLists.hpp"
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace ariel {
+
+    const size_t AdjacencyLists::ROWS_PER_BLOCK;
+
+    namespace {
+        /**
+         * Makes p the only owner of what it points to, copying it if it is shared.
+         * A count of 1 can't go up behind our back, only the owner could copy the pointer, and the
+         * fence orders our writes after the reads of the copies that were just released.
+         */
+        template<typename T>
+        T& unshare(std::shared_ptr<T>& p) {
+            if (p.use_count() != 1)
+                p = std::make_shared<T>(*p);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return *p;
+        }
+    }
+
+    /**
+     * Constructs an empty structure with no vertices.
+     */
+    AdjacencyLists::AdjacencyLists() : numVertices(0), numEdges(0) {}
+
+    /**
+     * Constructs n vertices with no edges.
+     */
+    AdjacencyLists::AdjacencyLists(size_t n) : numVertices(0), numEdges(0) {
+        for (size_t u = 0; u < n; ++u)
+            addVertex();
+    }
+
+    /**
+     * Replaces the outgoing edges of u.
+     * @param edges The new edges, in increasing order of the target vertex.
+     */
+    void AdjacencyLists::assignRow(size_t u, NeighborRange edges) {
+        Row& updated = writableRow(u);
+        numEdges -= updated.targets.size();
+        updated.targets.clear();
+        updated.weights.clear();
+        updated.targets.reserve(edges.size());
+        updated.weights.reserve(edges.size());
+        for (Neighbor edge : edges) {
+            updated.targets.push_back(edge.vertex);
+            updated.weights.push_back(edge.weight);
+        }
+        numEdges += updated.targets.size();
+    }
+
+    void AdjacencyLists::clear() {
+        blocks.clear();
+        numVertices = 0;
+        numEdges = 0;
+    }
+
+    /**
+     * Sets the weight of the edge u->v in O(degree of u), a weight of 0 removes the edge.
+     * Only copies the row of u if it is shared with a copy of the structure, and the edge changes.
+     */
+    void AdjacencyLists::setWeight(size_t u, size_t v, Weight weight) {
+        if (this->weight(u, v) == weight)
+            return;
+        Row& updated = writableRow(u);
+        std::vector<size_t>& targets = updated.targets;
+        auto it = std::lower_bound(targets.begin(), targets.end(), v);
+        auto pos = it - targets.begin();
+        bool present = it != targets.end() && *it == v;
+
+        if (present && weight == 0) {
+            targets.erase(it);
+            updated.weights.erase(updated.weights.begin() + pos);
+            --numEdges;
+        } else if (present) {
+            updated.weights[static_cast<size_t>(pos)] = weight;
+        } else {
+            targets.insert(it, v);
+            updated.weights.insert(updated.weights.begin() + pos, weight);
+            ++numEdges;
+        }
+    }
+
+    /**
+     * Adds a vertex with no edges, its number is the previous number of vertices.
+     */
+    void AdjacencyLists::addVertex() {
+        if (numVertices % ROWS_PER_BLOCK == 0)
+            blocks.push_back(std::make_shared<Block>(ROWS_PER_BLOCK));
+        ++numVertices;
+    }
+
+    size_t AdjacencyLists::V() const {
+        return numVertices;
+    }
+
+    size_t AdjacencyLists::E() const {
+        return numEdges;
+    }
+
+    size_t AdjacencyLists::degree(size_t u) const {
+        const Row* edges = row(u);
+        return edges == nullptr ? 0 : edges->targets.size();
+    }
+
+    /**
+     * Looks up the weight of the edge u->v with a binary search in the row of u.
+     * @return The weight of the edge, or 0 if there is no such edge.
+     */
+    Weight AdjacencyLists::weight(size_t u, size_t v) const {
+        const Row* edges = row(u);
+        if (edges == nullptr)
+            return 0;
+        auto it = std::lower_bound(edges->targets.begin(), edges->targets.end(), v);
+        if (it == edges->targets.end() || *it != v)
+            return 0;
+        return edges->weights[static_cast<size_t>(it - edges->targets.begin())];
+    }
+
+    NeighborRange AdjacencyLists::neighbors(size_t u) const {
+        const Row* edges = row(u);
+        if (edges == nullptr)
+            return NeighborRange(NeighborIterator(nullptr, nullptr), NeighborIterator(nullptr, nullptr), 0);
+        const size_t* first = edges->targets.data();
+        const Weight* firstWeight = edges->weights.data();
+        size_t count = edges->targets.size();
+        return NeighborRange(NeighborIterator(first, firstWeight),
+                             NeighborIterator(first + count, firstWeight + count),
+                             count);
+    }
+
+    /**
+     * Builds the CSR of the graph with every edge reversed, using a counting sort on the targets.
+     * @return The transposed adjacency structure, its rows sorted by source vertex.
+     */
+    CsrAdjacency AdjacencyLists::transposed() const {
+        size_t n = V();
+        std::vector<size_t> reversedOffsets(n + 1, 0);
+        for (size_t u = 0; u < n; ++u) {
+            for (Neighbor edge : neighbors(u))
+                ++reversedOffsets[edge.vertex + 1];
+        }
+        for (size_t v = 0; v < n; ++v)
+            reversedOffsets[v + 1] += reversedOffsets[v];
+
+        std::vector<size_t> reversedTargets(numEdges);
+        std::vector<Weight> reversedWeights(numEdges);
+        std::vector<size_t> next(reversedOffsets.begin(), reversedOffsets.end() - 1);
+        for (size_t u = 0; u < n; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                size_t pos = next[edge.vertex]++;
+                reversedTargets[pos] = u;
+                reversedWeights[pos] = edge.weight;
+            }
+        }
+        return CsrAdjacency(std::move(reversedOffsets), std::move(reversedTargets), std::move(reversedWeights));
+    }
+
+    /**
+     * The row of u, ready to be changed: its block and the row itself are copied first if a copy
+     * of the structure shares them.
+     */
+    AdjacencyLists::Row& AdjacencyLists::writableRow(size_t u) {
+        Block& block = unshare(blocks[u / ROWS_PER_BLOCK]);
+        std::shared_ptr<Row>& edges = block[u % ROWS_PER_BLOCK];
+        if (edges == nullptr)
+            edges = std::make_shared<Row>();
+        return unshare(edges);
+    }
+}
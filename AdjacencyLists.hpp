@@ -0,0 +1,61 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef ADJACENCY_LISTS_HPP
+#define ADJACENCY_LISTS_HPP
+
+#include "CsrAdjacency.hpp"
+#include "Neighbors.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Sparse storage for a graph that is being modified: every vertex keeps its own target and
+ * weight vectors, sorted by target vertex. Unlike CSR, an edge is added or removed in
+ * O(degree) without moving the rows of the other vertices, and a vertex is added in O(1).
+ * The rows are shared copy-on-write: they sit in blocks of ROWS_PER_BLOCK, and a copy of the
+ * structure only copies the pointers to the blocks. Changing a row then copies that row and the
+ * pointers of its block, so a copy that is changed in a few rows takes O(V / ROWS_PER_BLOCK)
+ * plus the size of those rows, and the rows it doesn't change stay shared with the original.
+ */
+
+namespace ariel {
+    class AdjacencyLists {
+    public:
+        static const size_t ROWS_PER_BLOCK = 64;
+
+        AdjacencyLists();
+        explicit AdjacencyLists(size_t n);
+
+        void assignRow(size_t u, NeighborRange edges);
+        void clear();
+        void setWeight(size_t u, size_t v, Weight weight);
+        void addVertex();
+
+        [[nodiscard]] size_t V() const;
+        [[nodiscard]] size_t E() const;
+        [[nodiscard]] size_t degree(size_t u) const;
+        [[nodiscard]] Weight weight(size_t u, size_t v) const;
+        [[nodiscard]] NeighborRange neighbors(size_t u) const;
+        [[nodiscard]] CsrAdjacency transposed() const;
+
+    private:
+        struct Row {
+            std::vector<size_t> targets;
+            std::vector<Weight> weights;
+        };
+        // a null row has no edges
+        typedef std::vector<std::shared_ptr<Row>> Block;
+
+        std::vector<std::shared_ptr<Block>> blocks;
+        size_t numVertices;
+        size_t numEdges;
+
+        [[nodiscard]] const Row* row(size_t u) const {
+            return (*blocks[u / ROWS_PER_BLOCK])[u % ROWS_PER_BLOCK].get();
+        }
+        Row& writableRow(size_t u);
+    };
+}
+
+#endif // ADJACENCY_LISTS_HPP
@@ -0,0 +1,72 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "AlgorithmResults.hpp"
+
+namespace ariel {
+
+    namespace {
+        // writes the vertices with separator between every two of them
+        void writeVertices(std::ostream& out, const std::vector<size_t>& vertices, const char* separator) {
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                if (i != 0)
+                    out << separator;
+                out << vertices[i];
+            }
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& out, const PathResult& result) {
+        if (result.status == PathStatus::NO_PATH)
+            return out << "There is no path from " << result.source << " to " << result.dest;
+        out << "Shortest path from " << result.source << " to " << result.dest << " is: ";
+        writeVertices(out, result.vertices, "->");
+        return out;
+    }
+
+    std::ostream& operator<<(std::ostream& out, const BipartiteResult& result) {
+        switch (result.status) {
+            case BipartiteStatus::EMPTY_GRAPH:
+                return out << "Graph is empty";
+            case BipartiteStatus::NOT_BIPARTITE:
+                return out << "Graph is not bipartite";
+            default:
+                break;
+        }
+        // A, then B, each in increasing order
+        out << "Graph is bipartite, A={";
+        for (int side = 0; side < 2; ++side) {
+            bool first = true;
+            for (size_t v = 0; v < result.inA.size(); ++v) {
+                if (result.inA[v] != (side == 0))
+                    continue;
+                if (!first)
+                    out << ",";
+                out << v;
+                first = false;
+            }
+            out << (side == 0 ? "}, B={" : "}");
+        }
+        return out;
+    }
+
+    std::ostream& operator<<(std::ostream& out, const CycleResult& result) {
+        switch (result.status) {
+            case CycleStatus::EMPTY_GRAPH:
+                return out << "Graph is empty";
+            case CycleStatus::NO_CYCLE:
+                return out << "No cycle found";
+            default:
+                out << "Cycle found: ";
+                writeVertices(out, result.vertices, "->");
+                return out;
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& out, const NegativeCycleResult& result) {
+        if (result.status != CycleStatus::FOUND)
+            return out << "No negative cycle detected in the graph";
+        out << "Negative cycle found: ";
+        writeVertices(out, result.vertices, " -> ");
+        return out;
+    }
+}
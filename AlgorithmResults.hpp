@@ -0,0 +1,77 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef ALGORITHM_RESULTS_HPP
+#define ALGORITHM_RESULTS_HPP
+
+#include "GraphProperties.hpp"
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ariel {
+
+    // Every result names the vertices by their original numbers, as they were before the graph was reordered.
+
+    enum class PathStatus { FOUND, NO_PATH };
+
+    /**
+     * The shortest path from source to dest: its vertices, source and dest included, and the sum of its weights.
+     * settled counts the vertices the search took off its queue or heap before it stopped, and every
+     * vertex once per run of Bellman-Ford, which scans them all.
+     */
+    struct PathResult {
+        PathStatus status;
+        size_t source;
+        size_t dest;
+        std::vector<size_t> vertices;
+        Distance cost;
+        size_t settled;
+    };
+
+    enum class BipartiteStatus { BIPARTITE, NOT_BIPARTITE, EMPTY_GRAPH };
+
+    /**
+     * The two sides of a bipartite graph: inA[v] is true for the vertices of A, false for the vertices of B.
+     * inA is empty unless the graph is bipartite.
+     */
+    struct BipartiteResult {
+        BipartiteStatus status;
+        std::vector<bool> inA;
+    };
+
+    enum class CycleStatus { FOUND, NO_CYCLE, EMPTY_GRAPH };
+
+    /**
+     * A cycle of the graph, as the vertices of the path that closes it: the last vertex is
+     * repeated where the path meets it.
+     */
+    struct CycleResult {
+        CycleStatus status;
+        std::vector<size_t> vertices;
+    };
+
+    /**
+     * A negative cycle of the graph, its first vertex repeated at its end.
+     */
+    struct NegativeCycleResult {
+        CycleStatus status;
+        std::vector<size_t> vertices;
+    };
+
+    // the messages the Algorithms methods that return strings give for these results
+    std::ostream& operator<<(std::ostream& out, const PathResult& result);
+    std::ostream& operator<<(std::ostream& out, const BipartiteResult& result);
+    std::ostream& operator<<(std::ostream& out, const CycleResult& result);
+    std::ostream& operator<<(std::ostream& out, const NegativeCycleResult& result);
+
+    template <typename Result>
+    std::string toMessage(const Result& result) {
+        std::ostringstream out;
+        out << result;
+        return out.str();
+    }
+}
+
+#endif // ALGORITHM_RESULTS_HPP
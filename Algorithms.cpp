@@ -28,4 +28,75 @@ namespace ariel {
     }
 
 
-}
\ No newline at end of file
+    std::string Algorithms::shortestPath(const Graph& g, size_t start, size_t end, QueryWorkspace& workspace) {
+        return ShortestPath::Execute(g, start, end, workspace);
+    }
+
+    bool Algorithms::isConnected(const Graph& g, QueryWorkspace& workspace) {
+        return IsConnected::Execute(g, workspace);
+    }
+
+    std::string Algorithms::isContainsCycle(const Graph &g, QueryWorkspace& workspace) {
+        return DetectCycle::Execute(g, workspace);
+    }
+
+    std::string Algorithms::isBipartite(const Graph &g, QueryWorkspace& workspace) {
+        return IsBipartite::Execute(g, workspace);
+    }
+
+    PathResult Algorithms::findShortestPath(const Graph& g, size_t start, size_t end) {
+        return ShortestPath::Find(g, start, end);
+    }
+
+    CycleResult Algorithms::findCycle(const Graph& g) {
+        return DetectCycle::Find(g);
+    }
+
+    NegativeCycleResult Algorithms::findNegativeCycle(const Graph& g) {
+        return DetectNegativeCycle::Find(g);
+    }
+
+    BipartiteResult Algorithms::findBipartition(const Graph& g) {
+        return IsBipartite::Find(g);
+    }
+
+    PathResult Algorithms::findShortestPath(const Graph& g, size_t start, size_t end, QueryWorkspace& workspace) {
+        return ShortestPath::Find(g, start, end, workspace);
+    }
+
+    CycleResult Algorithms::findCycle(const Graph& g, QueryWorkspace& workspace) {
+        return DetectCycle::Find(g, workspace);
+    }
+
+    BipartiteResult Algorithms::findBipartition(const Graph& g, QueryWorkspace& workspace) {
+        return IsBipartite::Find(g, workspace);
+    }
+
+    ShortestPathTree Algorithms::shortestPathTree(const Graph& g, size_t start) {
+        return ShortestPath::FindTree(g, start);
+    }
+
+    ShortestPathTree Algorithms::shortestPathTree(const Graph& g, size_t start, QueryWorkspace& workspace) {
+        return ShortestPath::FindTree(g, start, workspace);
+    }
+
+    std::string Algorithms::shortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options) {
+        QueryWorkspace workspace;
+        return ShortestPath::Execute(g, start, end, options, workspace);
+    }
+
+    std::string Algorithms::shortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options,
+                                         QueryWorkspace& workspace) {
+        return ShortestPath::Execute(g, start, end, options, workspace);
+    }
+
+    PathResult Algorithms::findShortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options) {
+        QueryWorkspace workspace;
+        return ShortestPath::Find(g, start, end, options, workspace);
+    }
+
+    PathResult Algorithms::findShortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options,
+                                            QueryWorkspace& workspace) {
+        return ShortestPath::Find(g, start, end, options, workspace);
+    }
+}
@@ -3,12 +3,14 @@
 #ifndef ALGORITHMS_HPP
 #define ALGORITHMS_HPP
 
+#include "AlgorithmResults.hpp"
 #include "Graph.hpp"
 #include "ShortestPath.hpp"
 #include "DetectCycle.hpp"
 #include "IsBipartite.hpp"
 #include "IsConnected.hpp"
 #include "DetectNegativeCycle.hpp"
+#include "QueryWorkspace.hpp"
 #include <string>
 
 namespace ariel {
@@ -20,6 +22,36 @@ namespace ariel {
         static std::string negativeCycle(const Graph& g);
         static std::string isBipartite(const Graph& g);
 
+        // the same queries with the scratch memory of a QueryWorkspace, which a thread can keep
+        // and pass to every query it runs, so they don't allocate memory
+        static bool isConnected(const Graph& g, QueryWorkspace& workspace);
+        static std::string shortestPath(const Graph& g, size_t start, size_t end, QueryWorkspace& workspace);
+        static std::string isContainsCycle(const Graph& g, QueryWorkspace& workspace);
+        static std::string isBipartite(const Graph& g, QueryWorkspace& workspace);
+
+        // the same queries answered with typed results instead of messages, which operator<< writes
+        // out as the messages above
+        static PathResult findShortestPath(const Graph& g, size_t start, size_t end);
+        static CycleResult findCycle(const Graph& g);
+        static NegativeCycleResult findNegativeCycle(const Graph& g);
+        static BipartiteResult findBipartition(const Graph& g);
+        static PathResult findShortestPath(const Graph& g, size_t start, size_t end, QueryWorkspace& workspace);
+        static CycleResult findCycle(const Graph& g, QueryWorkspace& workspace);
+        static BipartiteResult findBipartition(const Graph& g, QueryWorkspace& workspace);
+
+        // a shortest path searched the way the options ask for: from both ends, or with A* guided by a
+        // heuristic or by the bounds of landmarks (ALT), see PathOptions
+        static std::string shortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options);
+        static std::string shortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options,
+                                        QueryWorkspace& workspace);
+        static PathResult findShortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options);
+        static PathResult findShortestPath(const Graph& g, size_t start, size_t end, const PathOptions& options,
+                                           QueryWorkspace& workspace);
+
+        // the shortest paths from start to every vertex, for queries of many destinations of one source
+        static ShortestPathTree shortestPathTree(const Graph& g, size_t start);
+        static ShortestPathTree shortestPathTree(const Graph& g, size_t start, QueryWorkspace& workspace);
+
     };
 }
 #endif // ALGORITHMS_HPP
\ No newline at end of file
@@ -0,0 +1,143 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "BitMatrix.hpp"
+#include <algorithm>
+
+namespace ariel {
+
+    namespace {
+        const size_t BITS_PER_WORD = 64;
+    }
+
+    /**
+     * Constructs an empty matrix with no vertices.
+     */
+    BitMatrix::BitMatrix() : numVertices(0), wordsPerRow(0), numEdges(0) {}
+
+    /**
+     * Constructs an n x n matrix with no edges.
+     */
+    BitMatrix::BitMatrix(size_t n)
+            : words(n * ((n + BITS_PER_WORD - 1) / BITS_PER_WORD), 0), numVertices(n),
+              wordsPerRow((n + BITS_PER_WORD - 1) / BITS_PER_WORD), numEdges(0), degrees(n, 0),
+              inDegrees(n, 0) {}
+
+    /**
+     * Packs a square adjacency matrix, every non-zero entry becomes a set bit.
+     * @param matrix The adjacency matrix, assumed to be square and unweighted.
+     */
+    void BitMatrix::buildFromMatrix(const std::vector<std::vector<Weight>>& matrix) {
+        *this = BitMatrix(matrix.size());
+        for (size_t i = 0; i < numVertices; ++i) {
+            uint64_t* out = words.data() + i * wordsPerRow;
+            size_t degree = 0;
+            for (size_t j = 0; j < numVertices; ++j) {
+                if (matrix[i][j] != 0) {
+                    out[j / BITS_PER_WORD] |= uint64_t(1) << (j % BITS_PER_WORD);
+                    ++degree;
+                    ++inDegrees[j];
+                }
+            }
+            degrees[i] = degree;
+            numEdges += degree;
+        }
+    }
+
+    void BitMatrix::clear() {
+        *this = BitMatrix();
+    }
+
+    /**
+     * Adds or removes the edge u->v.
+     */
+    void BitMatrix::setEdge(size_t u, size_t v, bool present) {
+        uint64_t& word = words[u * wordsPerRow + v / BITS_PER_WORD];
+        uint64_t mask = uint64_t(1) << (v % BITS_PER_WORD);
+        bool wasPresent = (word & mask) != 0;
+        if (present && !wasPresent) {
+            word |= mask;
+            ++degrees[u];
+            ++inDegrees[v];
+            ++numEdges;
+        } else if (!present && wasPresent) {
+            word &= ~mask;
+            --degrees[u];
+            --inDegrees[v];
+            --numEdges;
+        }
+    }
+
+    size_t BitMatrix::V() const {
+        return numVertices;
+    }
+
+    size_t BitMatrix::E() const {
+        return numEdges;
+    }
+
+    size_t BitMatrix::rowWords() const {
+        return wordsPerRow;
+    }
+
+    size_t BitMatrix::degree(size_t u) const {
+        return degrees[u];
+    }
+
+    bool BitMatrix::hasEdge(size_t u, size_t v) const {
+        return (words[u * wordsPerRow + v / BITS_PER_WORD] >> (v % BITS_PER_WORD)) & 1U;
+    }
+
+    const uint64_t* BitMatrix::row(size_t u) const {
+        return words.data() + u * wordsPerRow;
+    }
+
+    NeighborRange BitMatrix::neighbors(size_t u) const {
+        const uint64_t* bitsOfU = row(u);
+        return NeighborRange(NeighborIterator(bitsOfU, 0, wordsPerRow),
+                             NeighborIterator(bitsOfU, wordsPerRow, wordsPerRow),
+                             degrees[u]);
+    }
+
+    size_t BitMatrix::inDegree(size_t v) const {
+        return inDegrees[v];
+    }
+
+    /**
+     * The incoming edges of v, found by testing bit v of every row in place.
+     */
+    NeighborRange BitMatrix::inNeighbors(size_t v) const {
+        const uint64_t* bits = words.data();
+        return NeighborRange(NeighborIterator(bits, wordsPerRow, v, 0, numVertices),
+                             NeighborIterator(bits, wordsPerRow, v, numVertices, numVertices),
+                             inDegrees[v]);
+    }
+
+    /**
+     * Builds the matrix of the graph with every edge reversed, visiting only the set bits.
+     */
+    BitMatrix BitMatrix::transposed() const {
+        BitMatrix result(numVertices);
+        for (size_t u = 0; u < numVertices; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                result.setEdge(edge.vertex, u, true);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Copies the matrix into an n x n one, the new rows and columns have no edges
+     * and the rows past n are dropped.
+     */
+    BitMatrix BitMatrix::resized(size_t n) const {
+        BitMatrix result(n);
+        size_t kept = std::min(n, numVertices);
+        for (size_t u = 0; u < kept; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                if (edge.vertex < kept)
+                    result.setEdge(u, edge.vertex, true);
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,49 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef BIT_MATRIX_HPP
+#define BIT_MATRIX_HPP
+
+#include "Neighbors.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Adjacency matrix of an unweighted graph with one bit per (u,v) pair.
+ * Every row is a whole number of 64 bit words, so a traversal can expand
+ * 64 candidate neighbors at once with word operations such as row & ~visited.
+ */
+
+namespace ariel {
+    class BitMatrix {
+    private:
+        std::vector<uint64_t> words;
+        size_t numVertices;
+        size_t wordsPerRow;
+        size_t numEdges;
+        std::vector<size_t> degrees;
+        std::vector<size_t> inDegrees;
+
+    public:
+        BitMatrix();
+        explicit BitMatrix(size_t n);
+
+        void buildFromMatrix(const std::vector<std::vector<Weight>>& matrix);
+        void clear();
+        void setEdge(size_t u, size_t v, bool present);
+
+        [[nodiscard]] size_t V() const;
+        [[nodiscard]] size_t E() const;
+        [[nodiscard]] size_t rowWords() const;
+        [[nodiscard]] size_t degree(size_t u) const;
+        [[nodiscard]] bool hasEdge(size_t u, size_t v) const;
+        [[nodiscard]] const uint64_t* row(size_t u) const;
+        [[nodiscard]] NeighborRange neighbors(size_t u) const;
+        [[nodiscard]] size_t inDegree(size_t v) const;
+        [[nodiscard]] NeighborRange inNeighbors(size_t v) const;
+        [[nodiscard]] BitMatrix transposed() const;
+        [[nodiscard]] BitMatrix resized(size_t n) const;
+    };
+}
+
+#endif // BIT_MATRIX_HPP
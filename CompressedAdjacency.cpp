@@ -0,0 +1,118 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "CompressedAdjacency.hpp"
+#include "Varint.hpp"
+#include <utility>
+
+namespace ariel {
+
+    /**
+     * Constructs an empty structure with no vertices.
+     */
+    CompressedAdjacency::CompressedAdjacency() : CompressedAdjacency(false) {}
+
+    /**
+     * Constructs an empty structure with no vertices.
+     * @param unitWeights True if every edge weighs 1, so the weights need not be stored.
+     */
+    CompressedAdjacency::CompressedAdjacency(bool unitWeights)
+            : offsets(1, 0), numEdges(0), unitWeights(unitWeights) {}
+
+    /**
+     * Adds a vertex with the given outgoing edges, its number is the previous number of vertices.
+     * @param edges The edges of the new vertex, in increasing order of the target vertex.
+     */
+    void CompressedAdjacency::appendRow(NeighborRange edges) {
+        int64_t u = static_cast<int64_t>(V());
+        varint::write(bytes, edges.size());
+        bool first = true;
+        size_t previous = 0;
+        for (Neighbor edge : edges) {
+            if (first)
+                varint::write(bytes, varint::zigzag(static_cast<int64_t>(edge.vertex) - u));
+            else
+                varint::write(bytes, edge.vertex - previous - 1);
+            if (!unitWeights)
+                varint::writeWeight(bytes, edge.weight);
+            previous = edge.vertex;
+            first = false;
+        }
+        numEdges += edges.size();
+        offsets.push_back(bytes.size());
+    }
+
+    void CompressedAdjacency::clear() {
+        offsets.assign(1, 0);
+        bytes.clear();
+        bytes.shrink_to_fit();
+        numEdges = 0;
+    }
+
+    size_t CompressedAdjacency::V() const {
+        return offsets.size() - 1;
+    }
+
+    size_t CompressedAdjacency::E() const {
+        return numEdges;
+    }
+
+    size_t CompressedAdjacency::degree(size_t u) const {
+        const uint8_t* cursor = bytes.data() + offsets[u];
+        return static_cast<size_t>(varint::read(cursor));
+    }
+
+    /**
+     * Looks up the weight of the edge u->v by decoding the row of u up to v.
+     * @return The weight of the edge, or 0 if there is no such edge.
+     */
+    Weight CompressedAdjacency::weight(size_t u, size_t v) const {
+        for (Neighbor edge : neighbors(u)) {
+            if (edge.vertex >= v)
+                return edge.vertex == v ? edge.weight : 0;
+        }
+        return 0;
+    }
+
+    NeighborRange CompressedAdjacency::neighbors(size_t u) const {
+        const uint8_t* cursor = bytes.data() + offsets[u];
+        size_t count = static_cast<size_t>(varint::read(cursor));
+        return NeighborRange(NeighborIterator(cursor, u, count, unitWeights),
+                             NeighborIterator(cursor, u, 0, unitWeights),
+                             count);
+    }
+
+    /**
+     * Builds the CSR of the graph with every edge reversed, decoding every row twice:
+     * once to count the edges into each vertex and once to place them.
+     * @return The transposed adjacency structure, its rows sorted by source vertex.
+     */
+    CsrAdjacency CompressedAdjacency::transposed() const {
+        size_t n = V();
+        std::vector<size_t> reversedOffsets(n + 1, 0);
+        for (size_t u = 0; u < n; ++u) {
+            for (Neighbor edge : neighbors(u))
+                ++reversedOffsets[edge.vertex + 1];
+        }
+        for (size_t v = 0; v < n; ++v)
+            reversedOffsets[v + 1] += reversedOffsets[v];
+
+        std::vector<size_t> reversedTargets(numEdges);
+        std::vector<Weight> reversedWeights(numEdges);
+        std::vector<size_t> next(reversedOffsets.begin(), reversedOffsets.end() - 1);
+        for (size_t u = 0; u < n; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                size_t pos = next[edge.vertex]++;
+                reversedTargets[pos] = u;
+                reversedWeights[pos] = edge.weight;
+            }
+        }
+        return CsrAdjacency(std::move(reversedOffsets), std::move(reversedTargets), std::move(reversedWeights));
+    }
+
+    /**
+     * @return The number of bytes taken by the row offsets and the encoded rows.
+     */
+    size_t CompressedAdjacency::byteSize() const {
+        return offsets.size() * sizeof(size_t) + bytes.size();
+    }
+}
@@ -0,0 +1,45 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef COMPRESSED_ADJACENCY_HPP
+#define COMPRESSED_ADJACENCY_HPP
+
+#include "CsrAdjacency.hpp"
+#include "Neighbors.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Read-only sparse storage for very large graphs: every row is a byte string holding its
+ * degree and then the sorted targets as variable length deltas, each followed by its weight.
+ * The first target is stored relative to the row's own vertex, so after a locality reordering
+ * most targets take a single byte. Unweighted graphs don't store the weights at all.
+ */
+
+namespace ariel {
+    class CompressedAdjacency {
+    private:
+        // the byte offset of every row in bytes, plus one past the last row
+        std::vector<size_t> offsets;
+        std::vector<uint8_t> bytes;
+        size_t numEdges;
+        bool unitWeights;
+
+    public:
+        CompressedAdjacency();
+        explicit CompressedAdjacency(bool unitWeights);
+
+        void appendRow(NeighborRange edges);
+        void clear();
+
+        [[nodiscard]] size_t V() const;
+        [[nodiscard]] size_t E() const;
+        [[nodiscard]] size_t degree(size_t u) const;
+        [[nodiscard]] Weight weight(size_t u, size_t v) const;
+        [[nodiscard]] NeighborRange neighbors(size_t u) const;
+        [[nodiscard]] CsrAdjacency transposed() const;
+        [[nodiscard]] size_t byteSize() const;
+    };
+}
+
+#endif // COMPRESSED_ADJACENCY_HPP
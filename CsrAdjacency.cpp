@@ -0,0 +1,284 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "CsrAdjacency.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace ariel {
+
+    /**
+     * Constructs an empty adjacency structure with no vertices.
+     */
+    CsrAdjacency::CsrAdjacency() : offsetData(nullptr), targetData(nullptr), weightData(nullptr),
+                                   numRows(0), numEdges(0) {}
+
+    /**
+     * Takes ownership of already built CSR arrays.
+     * @param offsets V+1 row offsets into targets and weights.
+     * @param targets The target vertex of every edge, sorted inside each row.
+     * @param weights The weight of every edge, parallel to targets.
+     */
+    CsrAdjacency::CsrAdjacency(std::vector<size_t> offsets, std::vector<size_t> targets, std::vector<Weight> weights)
+            : offsets(std::move(offsets)), targets(std::move(targets)), weights(std::move(weights)) {
+        useOwnedArrays();
+    }
+
+    CsrAdjacency::CsrAdjacency(const CsrAdjacency& other)
+            : offsets(other.offsets), targets(other.targets), weights(other.weights),
+              offsetData(other.offsetData), targetData(other.targetData), weightData(other.weightData),
+              numRows(other.numRows), numEdges(other.numEdges), borrowedOwner(other.borrowedOwner) {
+        // a view stays a view of the same memory, owned arrays point at the copied vectors
+        if (!isBorrowed())
+            useOwnedArrays();
+    }
+
+    // moving a vector keeps its buffer, so the array pointers stay valid
+    CsrAdjacency::CsrAdjacency(CsrAdjacency&& other) noexcept
+            : offsets(std::move(other.offsets)), targets(std::move(other.targets)), weights(std::move(other.weights)),
+              offsetData(other.offsetData), targetData(other.targetData), weightData(other.weightData),
+              numRows(other.numRows), numEdges(other.numEdges), borrowedOwner(std::move(other.borrowedOwner)) {
+        other.clear();
+    }
+
+    CsrAdjacency& CsrAdjacency::operator=(const CsrAdjacency& other) {
+        if (this != &other) {
+            CsrAdjacency copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    CsrAdjacency& CsrAdjacency::operator=(CsrAdjacency&& other) noexcept {
+        if (this != &other) {
+            offsets = std::move(other.offsets);
+            targets = std::move(other.targets);
+            weights = std::move(other.weights);
+            offsetData = other.offsetData;
+            targetData = other.targetData;
+            weightData = other.weightData;
+            numRows = other.numRows;
+            numEdges = other.numEdges;
+            borrowedOwner = std::move(other.borrowedOwner);
+            other.clear();
+        }
+        return *this;
+    }
+
+    /**
+     * Points the queries at the owned vectors, after they were rebuilt.
+     */
+    void CsrAdjacency::useOwnedArrays() {
+        borrowedOwner.reset();
+        offsetData = offsets.data();
+        targetData = targets.data();
+        weightData = weights.data();
+        numRows = offsets.empty() ? 0 : offsets.size() - 1;
+        numEdges = targets.size();
+    }
+
+    /**
+     * Builds the CSR arrays from a square adjacency matrix, keeping only the non-zero entries.
+     * Uses a counting pass and a fill pass so every array is allocated exactly once.
+     * @param matrix The adjacency matrix, assumed to be square.
+     */
+    void CsrAdjacency::buildFromMatrix(const std::vector<std::vector<Weight>>& matrix) {
+        size_t n = matrix.size();
+        offsets.assign(n + 1, 0);
+
+        // counting pass: the out degree of every vertex
+        for (size_t i = 0; i < n; ++i) {
+            size_t degree = 0;
+            for (Weight w : matrix[i]) {
+                if (w != 0)
+                    ++degree;
+            }
+            offsets[i + 1] = offsets[i] + degree;
+        }
+
+        // fill pass: columns are visited in order, so every row comes out sorted
+        targets.resize(offsets[n]);
+        weights.resize(offsets[n]);
+        for (size_t i = 0; i < n; ++i) {
+            size_t pos = offsets[i];
+            for (size_t j = 0; j < n; ++j) {
+                if (matrix[i][j] != 0) {
+                    targets[pos] = j;
+                    weights[pos] = matrix[i][j];
+                    ++pos;
+                }
+            }
+        }
+        useOwnedArrays();
+    }
+
+    /**
+     * Builds the CSR arrays straight from an edge list: a counting pass over the sources,
+     * a fill pass that buckets every edge into its row, then each row is sorted by target.
+     * Costs O(V + E log(max degree)) time and O(V+E) memory.
+     * @param numVertices The number of vertices, every endpoint must be smaller.
+     * @param edges The (source, target) pairs.
+     * @param edgeWeights The weight of every edge, or empty if every edge weighs 1.
+     *                    Edges of weight 0 are treated as missing, like 0 entries of a matrix.
+     * @throws std::invalid_argument if the same edge appears twice.
+     */
+    void CsrAdjacency::buildFromEdges(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges,
+                                      const std::vector<Weight>& edgeWeights) {
+        bool unitWeights = edgeWeights.empty();
+        offsets.assign(numVertices + 1, 0);
+
+        // counting pass: the out degree of every vertex
+        for (size_t e = 0; e < edges.size(); ++e) {
+            if (unitWeights || edgeWeights[e] != 0)
+                ++offsets[edges[e].first + 1];
+        }
+        for (size_t u = 0; u < numVertices; ++u)
+            offsets[u + 1] += offsets[u];
+
+        // fill pass: bucket the edges by source
+        targets.resize(offsets[numVertices]);
+        weights.resize(offsets[numVertices]);
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        for (size_t e = 0; e < edges.size(); ++e) {
+            Weight weight = unitWeights ? 1 : edgeWeights[e];
+            if (weight == 0)
+                continue;
+            size_t pos = next[edges[e].first]++;
+            targets[pos] = edges[e].second;
+            weights[pos] = weight;
+        }
+        next.clear();
+        next.shrink_to_fit();
+        useOwnedArrays();
+        sortRows();
+    }
+
+    /**
+     * Sorts every row by target, for owned arrays that were filled in any order.
+     * Costs O(E log(max degree)).
+     * @throws std::invalid_argument if the same edge appears twice, the structure is then cleared.
+     */
+    void CsrAdjacency::sortRows() {
+        std::vector<std::pair<size_t, Weight>> row;
+        for (size_t u = 0; u < V(); ++u) {
+            size_t begin = offsets[u];
+            size_t end = offsets[u + 1];
+            row.clear();
+            for (size_t e = begin; e < end; ++e)
+                row.emplace_back(targets[e], weights[e]);
+            std::sort(row.begin(), row.end());
+            for (size_t e = begin; e < end; ++e) {
+                targets[e] = row[e - begin].first;
+                weights[e] = row[e - begin].second;
+                if (e > begin && targets[e] == targets[e - 1]) {
+                    clear();
+                    throw std::invalid_argument("Invalid graph: the same edge appears more than once.");
+                }
+            }
+        }
+    }
+
+    /**
+     * Reads already built CSR arrays in place, without copying them.
+     * @param rowOffsets numVertices+1 row offsets into columnIndices and edgeWeights.
+     * @param columnIndices The target vertex of every edge, sorted inside each row.
+     * @param edgeWeights The weight of every edge, parallel to columnIndices.
+     * @param numVertices The number of vertices.
+     * @param owner Keeps the arrays alive for as long as this structure or a copy of it reads them.
+     */
+    void CsrAdjacency::borrowArrays(const size_t* rowOffsets, const size_t* columnIndices, const Weight* edgeWeights,
+                                    size_t numVertices, std::shared_ptr<const void> owner) {
+        clear();
+        offsetData = rowOffsets;
+        targetData = columnIndices;
+        weightData = edgeWeights;
+        numRows = numVertices;
+        numEdges = rowOffsets[numVertices];
+        borrowedOwner = std::move(owner);
+    }
+
+    void CsrAdjacency::clear() {
+        offsets.clear();
+        targets.clear();
+        weights.clear();
+        useOwnedArrays();
+    }
+
+    /**
+     * Whether the arrays live in memory owned by someone else, see borrowArrays.
+     */
+    bool CsrAdjacency::isBorrowed() const {
+        return borrowedOwner != nullptr;
+    }
+
+    size_t CsrAdjacency::V() const {
+        return numRows;
+    }
+
+    size_t CsrAdjacency::E() const {
+        return numEdges;
+    }
+
+    size_t CsrAdjacency::degree(size_t u) const {
+        return offsetData[u + 1] - offsetData[u];
+    }
+
+    /**
+     * Looks up the weight of the edge u->v with a binary search in the row of u.
+     * @return The weight of the edge, or 0 if there is no such edge.
+     */
+    Weight CsrAdjacency::weight(size_t u, size_t v) const {
+        const size_t* first = targetData + offsetData[u];
+        const size_t* last = targetData + offsetData[u + 1];
+        const size_t* it = std::lower_bound(first, last, v);
+        if (it == last || *it != v)
+            return 0;
+        return weightData[it - targetData];
+    }
+
+    NeighborRange CsrAdjacency::neighbors(size_t u) const {
+        size_t begin = offsetData[u];
+        size_t end = offsetData[u + 1];
+        return NeighborRange(NeighborIterator(targetData + begin, weightData + begin),
+                             NeighborIterator(targetData + end, weightData + end),
+                             end - begin);
+    }
+
+    /**
+     * Builds the CSR of the graph with every edge reversed, using a counting sort on the targets.
+     * Rows are filled in increasing source order, so the result is sorted as well.
+     * @return The transposed adjacency structure.
+     */
+    CsrAdjacency CsrAdjacency::transposed() const {
+        size_t n = V();
+        std::vector<size_t> reversedOffsets(n + 1, 0);
+        for (size_t e = 0; e < numEdges; ++e)
+            ++reversedOffsets[targetData[e] + 1];
+        for (size_t v = 0; v < n; ++v)
+            reversedOffsets[v + 1] += reversedOffsets[v];
+
+        std::vector<size_t> reversedTargets(numEdges);
+        std::vector<Weight> reversedWeights(numEdges);
+        std::vector<size_t> next(reversedOffsets.begin(), reversedOffsets.end() - 1);
+        for (size_t u = 0; u < n; ++u) {
+            for (size_t e = offsetData[u]; e < offsetData[u + 1]; ++e) {
+                size_t pos = next[targetData[e]]++;
+                reversedTargets[pos] = u;
+                reversedWeights[pos] = weightData[e];
+            }
+        }
+        return CsrAdjacency(std::move(reversedOffsets), std::move(reversedTargets), std::move(reversedWeights));
+    }
+
+    const size_t* CsrAdjacency::rowOffsets() const {
+        return offsetData;
+    }
+
+    const size_t* CsrAdjacency::columnIndices() const {
+        return targetData;
+    }
+
+    const Weight* CsrAdjacency::edgeWeights() const {
+        return weightData;
+    }
+}
@@ -0,0 +1,68 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef CSR_ADJACENCY_HPP
+#define CSR_ADJACENCY_HPP
+
+#include "Neighbors.hpp"
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Compressed sparse row storage of a graph: the outgoing edges of vertex u are
+ * targets[offsets[u] .. offsets[u+1]) with the matching entries of weights,
+ * sorted by target vertex. Memory is O(V+E) instead of O(V^2).
+ *
+ * The arrays can also be read in place from memory the structure doesn't own, such as a
+ * mapped graph file, which is then kept alive by the structure and its copies.
+ */
+
+namespace ariel {
+    class CsrAdjacency {
+    private:
+        std::vector<size_t> offsets;
+        std::vector<size_t> targets;
+        std::vector<Weight> weights;
+        // the arrays read by every query, either the vectors above or borrowed memory
+        const size_t* offsetData;
+        const size_t* targetData;
+        const Weight* weightData;
+        size_t numRows;
+        size_t numEdges;
+        std::shared_ptr<const void> borrowedOwner;
+
+        void useOwnedArrays();
+
+    public:
+        CsrAdjacency();
+        CsrAdjacency(std::vector<size_t> offsets, std::vector<size_t> targets, std::vector<Weight> weights);
+        CsrAdjacency(const CsrAdjacency& other);
+        CsrAdjacency(CsrAdjacency&& other) noexcept;
+        CsrAdjacency& operator=(const CsrAdjacency& other);
+        CsrAdjacency& operator=(CsrAdjacency&& other) noexcept;
+
+        void buildFromMatrix(const std::vector<std::vector<Weight>>& matrix);
+        void buildFromEdges(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges,
+                            const std::vector<Weight>& edgeWeights);
+        void sortRows();
+        void borrowArrays(const size_t* rowOffsets, const size_t* columnIndices, const Weight* edgeWeights,
+                          size_t numVertices, std::shared_ptr<const void> owner);
+        void clear();
+
+        [[nodiscard]] bool isBorrowed() const;
+
+        [[nodiscard]] size_t V() const;
+        [[nodiscard]] size_t E() const;
+        [[nodiscard]] size_t degree(size_t u) const;
+        [[nodiscard]] Weight weight(size_t u, size_t v) const;
+        [[nodiscard]] NeighborRange neighbors(size_t u) const;
+        [[nodiscard]] CsrAdjacency transposed() const;
+
+        [[nodiscard]] const size_t* rowOffsets() const;
+        [[nodiscard]] const size_t* columnIndices() const;
+        [[nodiscard]] const Weight* edgeWeights() const;
+    };
+}
+
+#endif // CSR_ADJACENCY_HPP
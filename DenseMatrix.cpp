@@ -0,0 +1,344 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "DenseMatrix.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace ariel {
+
+    namespace {
+        const size_t CELLS_PER_LINE = DenseMatrix::CACHE_LINE_BYTES / sizeof(Weight);
+        // transpose works on square tiles that fit comfortably in L1
+        const size_t TRANSPOSE_TILE = 32;
+    }
+
+    /**
+     * Constructs an empty matrix with no vertices.
+     */
+    DenseMatrix::DenseMatrix() : ownedCells(nullptr), cells(nullptr), numVertices(0), stride(0), numEdges(0) {}
+
+    /**
+     * Constructs an n x n matrix with no edges.
+     */
+    DenseMatrix::DenseMatrix(size_t n) : ownedCells(nullptr), cells(nullptr), numVertices(0), stride(0), numEdges(0) {
+        allocate(n);
+    }
+
+    DenseMatrix::DenseMatrix(const DenseMatrix& other)
+            : ownedCells(nullptr), cells(nullptr), numVertices(0), stride(0), numEdges(0) {
+        if (other.ownedCells != nullptr) {
+            allocate(other.numVertices);
+            std::memcpy(ownedCells, other.ownedCells, numVertices * stride * sizeof(Weight));
+        } else if (!other.ownedRows.empty()) {
+            ownedRows = other.ownedRows;
+            for (const auto& row : ownedRows)
+                rowTable.push_back(row.data());
+        } else {
+            // a view stays a view of the same memory
+            cells = other.cells;
+            rowTable = other.rowTable;
+        }
+        numVertices = other.numVertices;
+        stride = other.stride;
+        numEdges = other.numEdges;
+        degrees = other.degrees;
+        inDegrees = other.inDegrees;
+    }
+
+    DenseMatrix::DenseMatrix(DenseMatrix&& other) noexcept
+            : ownedCells(other.ownedCells), cells(other.cells), ownedRows(std::move(other.ownedRows)),
+              rowTable(std::move(other.rowTable)), numVertices(other.numVertices), stride(other.stride),
+              numEdges(other.numEdges), degrees(std::move(other.degrees)), inDegrees(std::move(other.inDegrees)) {
+        other.ownedCells = nullptr;
+        other.release();
+    }
+
+    DenseMatrix& DenseMatrix::operator=(const DenseMatrix& other) {
+        if (this != &other) {
+            DenseMatrix copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    DenseMatrix& DenseMatrix::operator=(DenseMatrix&& other) noexcept {
+        if (this != &other) {
+            release();
+            ownedCells = other.ownedCells;
+            cells = other.cells;
+            ownedRows = std::move(other.ownedRows);
+            rowTable = std::move(other.rowTable);
+            numVertices = other.numVertices;
+            stride = other.stride;
+            numEdges = other.numEdges;
+            degrees = std::move(other.degrees);
+            inDegrees = std::move(other.inDegrees);
+            other.ownedCells = nullptr;
+            other.release();
+        }
+        return *this;
+    }
+
+    DenseMatrix::~DenseMatrix() {
+        release();
+    }
+
+    /**
+     * Allocates a zeroed n x n matrix in one cache line aligned block,
+     * with the row stride rounded up to a whole number of cache lines.
+     * @throws std::bad_alloc if the allocation fails.
+     */
+    void DenseMatrix::allocate(size_t n) {
+        release();
+        numVertices = n;
+        stride = (n + CELLS_PER_LINE - 1) / CELLS_PER_LINE * CELLS_PER_LINE;
+        degrees.assign(n, 0);
+        inDegrees.assign(n, 0);
+        if (n == 0)
+            return;
+
+        size_t bytes = n * stride * sizeof(Weight);
+        void* block = nullptr;
+        if (posix_memalign(&block, CACHE_LINE_BYTES, bytes) != 0)
+            throw std::bad_alloc();
+        std::memset(block, 0, bytes);
+        ownedCells = static_cast<Weight*>(block);
+        cells = ownedCells;
+    }
+
+    void DenseMatrix::release() {
+        std::free(ownedCells);
+        ownedCells = nullptr;
+        cells = nullptr;
+        ownedRows.clear();
+        rowTable.clear();
+        numVertices = 0;
+        stride = 0;
+        numEdges = 0;
+        degrees.clear();
+        inDegrees.clear();
+    }
+
+    /**
+     * Recomputes the degree of every row and column and the number of edges.
+     */
+    void DenseMatrix::countEdges() {
+        degrees.assign(numVertices, 0);
+        inDegrees.assign(numVertices, 0);
+        numEdges = 0;
+        for (size_t i = 0; i < numVertices; ++i) {
+            const Weight* in = row(i);
+            size_t degree = 0;
+            for (size_t j = 0; j < numVertices; ++j) {
+                if (in[j] != 0) {
+                    ++degree;
+                    ++inDegrees[j];
+                }
+            }
+            degrees[i] = degree;
+            numEdges += degree;
+        }
+    }
+
+    /**
+     * Copies a borrowed matrix into an owned block, so it can be modified.
+     */
+    void DenseMatrix::makeWritable() {
+        if (!isBorrowed())
+            return;
+        DenseMatrix copy(numVertices);
+        for (size_t i = 0; i < numVertices; ++i)
+            std::memcpy(copy.ownedCells + i * copy.stride, row(i), numVertices * sizeof(Weight));
+        copy.degrees = degrees;
+        copy.inDegrees = inDegrees;
+        copy.numEdges = numEdges;
+        *this = std::move(copy);
+    }
+
+    /**
+     * Copies a square adjacency matrix into the flat layout.
+     * @param matrix The adjacency matrix, assumed to be square.
+     */
+    void DenseMatrix::buildFromMatrix(const std::vector<std::vector<Weight>>& matrix) {
+        allocate(matrix.size());
+        for (size_t i = 0; i < numVertices; ++i)
+            std::copy(matrix[i].begin(), matrix[i].end(), ownedCells + i * stride);
+        countEdges();
+    }
+
+    /**
+     * Takes over the rows of a nested matrix without copying them.
+     * @param matrix The adjacency matrix, assumed to be square. It is left empty.
+     */
+    void DenseMatrix::adoptRows(std::vector<std::vector<Weight>>&& matrix) {
+        release();
+        ownedRows = std::move(matrix);
+        numVertices = ownedRows.size();
+        stride = numVertices;
+        for (const auto& row : ownedRows)
+            rowTable.push_back(row.data());
+        countEdges();
+    }
+
+    /**
+     * Reads the rows of a nested matrix in place. The caller keeps ownership and must keep
+     * the matrix alive and unchanged for as long as this object (or a copy of it) uses it.
+     * @param matrix The adjacency matrix, assumed to be square.
+     */
+    void DenseMatrix::borrowRows(const std::vector<std::vector<Weight>>& matrix) {
+        release();
+        numVertices = matrix.size();
+        stride = numVertices;
+        for (const auto& row : matrix)
+            rowTable.push_back(row.data());
+        countEdges();
+    }
+
+    /**
+     * Reads a flat row-major buffer in place, with the same lifetime rules as borrowRows.
+     * @param data The n x rowStride buffer, cell (u,v) is data[u * rowStride + v].
+     * @param n The number of vertices.
+     * @param rowStride The distance between the starts of two consecutive rows, at least n.
+     */
+    void DenseMatrix::borrowCells(const Weight* data, size_t n, size_t rowStride) {
+        release();
+        numVertices = n;
+        stride = rowStride;
+        if (n > 0)
+            cells = data;
+        countEdges();
+    }
+
+    void DenseMatrix::clear() {
+        release();
+    }
+
+    /**
+     * Sets the weight of the edge u->v, a weight of 0 removes the edge.
+     * A borrowed matrix is copied first, the caller's memory is never written.
+     */
+    void DenseMatrix::setWeight(size_t u, size_t v, Weight weight) {
+        makeWritable();
+        Weight& cell = ownedCells != nullptr ? ownedCells[u * stride + v] : ownedRows[u][v];
+        if (cell == 0 && weight != 0) {
+            ++degrees[u];
+            ++inDegrees[v];
+            ++numEdges;
+        } else if (cell != 0 && weight == 0) {
+            --degrees[u];
+            --inDegrees[v];
+            --numEdges;
+        }
+        cell = weight;
+    }
+
+    /**
+     * Whether the cells live in memory owned by someone else.
+     */
+    bool DenseMatrix::isBorrowed() const {
+        return ownedCells == nullptr && ownedRows.empty() && numVertices > 0;
+    }
+
+    size_t DenseMatrix::V() const {
+        return numVertices;
+    }
+
+    size_t DenseMatrix::E() const {
+        return numEdges;
+    }
+
+    size_t DenseMatrix::rowStride() const {
+        return stride;
+    }
+
+    size_t DenseMatrix::degree(size_t u) const {
+        return degrees[u];
+    }
+
+    Weight DenseMatrix::weight(size_t u, size_t v) const {
+        return cells != nullptr ? cells[u * stride + v] : rowTable[u][v];
+    }
+
+    const Weight* DenseMatrix::row(size_t u) const {
+        return cells != nullptr ? cells + u * stride : rowTable[u];
+    }
+
+    NeighborRange DenseMatrix::neighbors(size_t u) const {
+        const Weight* cellsOfU = row(u);
+        return NeighborRange(NeighborIterator(cellsOfU, 0, numVertices),
+                             NeighborIterator(cellsOfU, numVertices, numVertices),
+                             degrees[u]);
+    }
+
+    size_t DenseMatrix::inDegree(size_t v) const {
+        return inDegrees[v];
+    }
+
+    /**
+     * The incoming edges of v, read down column v of the matrix in place: a stride apart in a flat
+     * matrix, through the row table in one kept as nested rows.
+     */
+    NeighborRange DenseMatrix::inNeighbors(size_t v) const {
+        if (cells != nullptr)
+            return NeighborRange(NeighborIterator(cells, stride, v, 0, numVertices),
+                                 NeighborIterator(cells, stride, v, numVertices, numVertices),
+                                 inDegrees[v]);
+        const Weight* const* rows = rowTable.data();
+        return NeighborRange(NeighborIterator(rows, v, 0, numVertices),
+                             NeighborIterator(rows, v, numVertices, numVertices),
+                             inDegrees[v]);
+    }
+
+    /**
+     * Builds the transposed matrix tile by tile, so both the reads and the writes
+     * stay inside a few cache lines instead of striding over whole columns.
+     * @return The matrix of the graph with every edge reversed, in an owned block.
+     */
+    DenseMatrix DenseMatrix::transposed() const {
+        DenseMatrix result(numVertices);
+        for (size_t ii = 0; ii < numVertices; ii += TRANSPOSE_TILE) {
+            size_t iEnd = std::min(ii + TRANSPOSE_TILE, numVertices);
+            for (size_t jj = 0; jj < numVertices; jj += TRANSPOSE_TILE) {
+                size_t jEnd = std::min(jj + TRANSPOSE_TILE, numVertices);
+                for (size_t i = ii; i < iEnd; ++i) {
+                    const Weight* in = row(i);
+                    for (size_t j = jj; j < jEnd; ++j) {
+                        result.ownedCells[j * result.stride + i] = in[j];
+                        if (in[j] != 0)
+                            ++result.degrees[j];
+                    }
+                }
+            }
+        }
+        result.numEdges = numEdges;
+        result.inDegrees = degrees;
+        return result;
+    }
+
+    /**
+     * Copies the matrix into an owned n x n one, the new rows and columns have no edges
+     * and the rows past n are dropped.
+     */
+    DenseMatrix DenseMatrix::resized(size_t n) const {
+        DenseMatrix result(n);
+        size_t kept = std::min(n, numVertices);
+        for (size_t i = 0; i < kept; ++i) {
+            const Weight* in = row(i);
+            Weight* out = result.ownedCells + i * result.stride;
+            size_t degree = 0;
+            for (size_t j = 0; j < kept; ++j) {
+                out[j] = in[j];
+                if (in[j] != 0) {
+                    ++degree;
+                    ++result.inDegrees[j];
+                }
+            }
+            result.degrees[i] = degree;
+            result.numEdges += degree;
+        }
+        return result;
+    }
+}
@@ -0,0 +1,73 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef DENSE_MATRIX_HPP
+#define DENSE_MATRIX_HPP
+
+#include "Neighbors.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Dense adjacency matrix kept in a single row-major allocation.
+ * The buffer is aligned to a cache line and every row is padded to a whole number of
+ * cache lines, so each row starts on its own line and row scans stream through memory.
+ *
+ * To avoid copying large inputs the matrix can also sit on top of memory it didn't allocate:
+ * rows adopted from a moved-in nested matrix, or a read-only view of the caller's rows or
+ * flat buffer. A view is copied into an owned block the first time it is written to.
+ */
+
+namespace ariel {
+    class DenseMatrix {
+    private:
+        Weight* ownedCells;
+        // the cells of a flat matrix, owned or borrowed, cell (u,v) is cells[u * stride + v]
+        const Weight* cells;
+        std::vector<std::vector<Weight>> ownedRows;
+        // the start of every row of a matrix kept as nested rows, adopted or borrowed, empty otherwise
+        std::vector<const Weight*> rowTable;
+        size_t numVertices;
+        size_t stride;
+        size_t numEdges;
+        std::vector<size_t> degrees;
+        std::vector<size_t> inDegrees;
+
+        void allocate(size_t n);
+        void release();
+        void countEdges();
+        void makeWritable();
+
+    public:
+        static const size_t CACHE_LINE_BYTES = 64;
+
+        DenseMatrix();
+        explicit DenseMatrix(size_t n);
+        DenseMatrix(const DenseMatrix& other);
+        DenseMatrix(DenseMatrix&& other) noexcept;
+        DenseMatrix& operator=(const DenseMatrix& other);
+        DenseMatrix& operator=(DenseMatrix&& other) noexcept;
+        ~DenseMatrix();
+
+        void buildFromMatrix(const std::vector<std::vector<Weight>>& matrix);
+        void adoptRows(std::vector<std::vector<Weight>>&& matrix);
+        void borrowRows(const std::vector<std::vector<Weight>>& matrix);
+        void borrowCells(const Weight* data, size_t n, size_t rowStride);
+        void clear();
+        void setWeight(size_t u, size_t v, Weight weight);
+
+        [[nodiscard]] bool isBorrowed() const;
+        [[nodiscard]] size_t V() const;
+        [[nodiscard]] size_t E() const;
+        [[nodiscard]] size_t rowStride() const;
+        [[nodiscard]] size_t degree(size_t u) const;
+        [[nodiscard]] Weight weight(size_t u, size_t v) const;
+        [[nodiscard]] const Weight* row(size_t u) const;
+        [[nodiscard]] NeighborRange neighbors(size_t u) const;
+        [[nodiscard]] size_t inDegree(size_t v) const;
+        [[nodiscard]] NeighborRange inNeighbors(size_t v) const;
+        [[nodiscard]] DenseMatrix transposed() const;
+        [[nodiscard]] DenseMatrix resized(size_t n) const;
+    };
+}
+
+#endif // DENSE_MATRIX_HPP
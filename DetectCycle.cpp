@@ -1,6 +1,8 @@
 //written by Ido Avraham : 208699181
 //EMAIL: idoavraham086@gmail.com
 #include "DetectCycle.hpp"
+#include <algorithm>
+#include <cstddef>
 
 namespace ariel {
 
@@ -10,10 +12,38 @@ namespace ariel {
     * @return A string describing the detected cycle, or a message indicating no cycle was found.
     */
     std::string DetectCycle::Execute(const Graph &g) {
+        QueryWorkspace workspace;
+        return Execute(g, workspace);
+    }
+
+    /**
+    * Executes the cycle detection algorithm on the given graph, keeping its marks and path in workspace.
+    * @param workspace Reused by every query of the calling thread, so the search doesn't allocate memory.
+    */
+    std::string DetectCycle::Execute(const Graph &g, QueryWorkspace& workspace) {
+        return toMessage(Find(g, workspace));
+    }
+
+    /**
+    * Looks for a cycle in the given graph.
+    * @param g The graph to detect cycles in.
+    * @return The vertices of the cycle found, or the status if none was.
+    */
+    CycleResult DetectCycle::Find(const Graph &g) {
+        QueryWorkspace workspace;
+        return Find(g, workspace);
+    }
+
+    /**
+    * Looks for a cycle in the given graph, keeping its marks and path in workspace.
+    * @param workspace Reused by every query of the calling thread, so only the result allocates memory.
+    */
+    CycleResult DetectCycle::Find(const Graph &g, QueryWorkspace& workspace) {
         // empty graph
         if (g.isEmpty())
-            return "Graph is empty";
-        return detectCycle(g);
+            return CycleResult{CycleStatus::EMPTY_GRAPH, std::vector<size_t>()};
+        workspace.reset(g.V());
+        return detectCycle(g, workspace);
 
     }
 
@@ -21,83 +51,91 @@ namespace ariel {
     * Detects cycles in the given graph using Depth-First Search (DFS).
     * the general strategy is to seek for a back edge.
     * @param g The graph to detect cycles in.
-    * @return A string describing the detected cycle, or a message indicating no cycle was found.
+    * @return The detected cycle, or NO_CYCLE.
     */
-    std::string DetectCycle::detectCycle(const Graph &g) {
-        // Initialize vectors to track visited vertices and recursion stack
-        std::vector<bool> visited(g.V(), false);
-        std::vector<size_t> path; // To store the current path
-
-        // Iterate through all vertices and perform DFS to detect cycles
-        for (size_t v = 0; v < g.V(); ++v) {
-            if (!visited[v]) {
-                if (detectCycleDfs(g, v, -1, visited, path))
-                    return constructCycleString(path);
+    CycleResult DetectCycle::detectCycle(const Graph &g, QueryWorkspace& workspace) {
+        // The state of a vertex is 1 while it is on the current path (for O(1) lookups), and 2 once
+        // it is done, 0 until it is visited
+        std::vector<size_t>& path = workspace.path(); // To store the current path
+
+        // Iterate through all vertices (in their original order) and perform DFS to detect cycles
+        for (size_t i = 0; i < g.V(); ++i) {
+            size_t v = g.internalId(i);
+            if (workspace.state(v) == 0) {
+                if (detectCycleDfs(g, v, workspace, path))
+                    return constructCycle(g, path);
             }
         }
 
-        // If no cycle is found, return a message indicating so
-        return "No cycle found";
+        // No cycle is found
+        return CycleResult{CycleStatus::NO_CYCLE, std::vector<size_t>()};
     }
 
     /**
        * Depth-First Search (DFS) traversal to detect cycles in the graph starting from a given vertex.
+       * Uses an explicit stack instead of recursion, so deep graphs can't overflow the call stack. The
+       * stack keeps, above a marker for every vertex of the path, the neighbors of that vertex that are
+       * still to be tried, so they are tried in the same order and at the same point as by recursion.
        * @param g The graph to detect cycles in.
-       * @param v The current vertex being explored.
-       * @param parent The parent vertex of the current vertex.
-       * @param visited A vector to track visited vertices.
+       * @param start The vertex to start the traversal from.
+       * @param workspace Marks the visited vertices, and the vertices that are currently in path, and
+       * keeps the stack of the traversal.
        * @param path A vector to store the current path during traversal.
        * @return True if a cycle is found, false otherwise.
        */
-    bool DetectCycle::detectCycleDfs(const Graph &g, size_t v, int parent, std::vector<bool> &visited, std::vector<size_t> &path) {
-        visited[v] = true;
-        path.push_back(v);
+    bool DetectCycle::detectCycleDfs(const Graph &g, size_t start, QueryWorkspace& workspace,
+                                     std::vector<size_t> &path) {
+        // the marker below the neighbors of the last vertex of the path
+        const size_t BACKTRACK = QueryWorkspace::NO_VERTEX;
+        std::vector<size_t>& stack = workspace.queue();
+        stack.clear();
+        stack.push_back(start);
 
-        // Explore all neighbors of vertex v
-        for (size_t neighbor = 0; neighbor < g.V(); ++neighbor) {
-            int weight = g.getEdgeWeight(v, neighbor);
-            if (weight != 0) {
+        while (!stack.empty()) {
+            size_t v = stack.back();
+            stack.pop_back();
 
+            // All neighbors of the last vertex are tried, remove it from the current path as we backtrack
+            if (v == BACKTRACK) {
+                workspace.setState(path.back(), 2);
+                path.pop_back();
+                continue;
+            }
+
+            if (!path.empty()) {
                 // For undirected graphs, ignore the edge to the parent
-                if (g.getGraphType() == GraphType::UNDIRECTED) {
-                    if (neighbor == parent)
-                        continue;
-                }
+                if (g.getGraphType() == GraphType::UNDIRECTED && path.size() > 1 && v == path[path.size() - 2])
+                    continue;
                 // If the neighbor is already in the path, a cycle is found
-                bool inPath = false;
-                for (size_t i: path) {
-                    if (i == neighbor) {
-                        inPath = true;
-                        break;
-                    }
-                }
-                if (inPath) {
-                    path.push_back(neighbor); // Include the neighbor to complete the cycle
+                if (workspace.state(v) == 1) {
+                    path.push_back(v); // Include the neighbor to complete the cycle
                     return true;
                 }
-                // If the neighbor has not been visited yet, explore it recursively
-                if (!visited[neighbor] && detectCycleDfs(g, neighbor, v, visited, path))
-                    return true;
+                // Only a neighbor that has not been visited yet is explored
+                if (workspace.state(v) != 0)
+                    continue;
             }
-        }
 
-        // Remove v from the current path as we backtrack
-        path.pop_back();
+            workspace.setState(v, 1);
+            path.push_back(v);
+            stack.push_back(BACKTRACK);
+            // push the neighbors of v so the first one is on top, to be tried first
+            size_t first = stack.size();
+            for (Neighbor edge : g.neighbors(v))
+                stack.push_back(edge.vertex);
+            std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(first), stack.end());
+        }
         return false;
     }
 
 
-    // Constructs a string representation of the detected cycle.
-    std::string DetectCycle::constructCycleString(const std::vector<size_t> &path) {
-        // Construct the cycle string from the path
-        std::stringstream ss;
-        ss << "Cycle found: ";
-        for (size_t i = 0; i < path.size(); ++i) {
-            ss << path[i];
-            if (i < path.size() - 1)
-                ss << "->";
-        }
-        return ss.str();
+    // Constructs the detected cycle, with the original vertex numbers.
+    CycleResult DetectCycle::constructCycle(const Graph &g, const std::vector<size_t> &path) {
+        CycleResult result{CycleStatus::FOUND, std::vector<size_t>()};
+        result.vertices.reserve(path.size());
+        for (size_t v : path)
+            result.vertices.push_back(g.originalId(v));
+        return result;
     }
 
 }//name space ariel
@@ -3,6 +3,7 @@
 #ifndef DETECT_CYCLE_HPP
 #define DETECT_CYCLE_HPP
 
+#include "AlgorithmResults.hpp"
 #include "Graph.hpp"
 #include "ShortestPath.hpp"
 using namespace std;
@@ -12,10 +13,14 @@ namespace ariel {
     class DetectCycle {
     public:
         static std::string Execute(const Graph &g);
+        static std::string Execute(const Graph &g, QueryWorkspace& workspace);
+        static CycleResult Find(const Graph &g);
+        static CycleResult Find(const Graph &g, QueryWorkspace& workspace);
     private:
-        static std::string detectCycle(const Graph& g);
-        static bool detectCycleDfs(const Graph &g, size_t v,int parent, std::vector<bool> &visited, std::vector<size_t> &path);
-        static std::string constructCycleString(const std::vector<size_t> &path);
+        static CycleResult detectCycle(const Graph& g, QueryWorkspace& workspace);
+        static bool detectCycleDfs(const Graph &g, size_t start, QueryWorkspace& workspace,
+                                   std::vector<size_t> &path);
+        static CycleResult constructCycle(const Graph &g, const std::vector<size_t> &path);
     };
 
 }
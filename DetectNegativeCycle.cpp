@@ -3,14 +3,25 @@
 #include "DetectNegativeCycle.hpp"
 namespace ariel {
 
+    constexpr Distance DetectNegativeCycle::VIRTUAL_SOURCE_WEIGHT;
+
     /**
     * Executes the negative cycle detection algorithm on the given graph.
     * @param g The graph on which to perform negative cycle detection.
     * @return A string indicating the presence or absence of negative cycles.
     */
     std::string DetectNegativeCycle::Execute(const ariel::Graph &g) {
+        return toMessage(Find(g));
+    }
+
+    /**
+    * Looks for a negative cycle in the given graph.
+    * @param g The graph on which to perform negative cycle detection.
+    * @return The vertices of the negative cycle found, or NO_CYCLE.
+    */
+    NegativeCycleResult DetectNegativeCycle::Find(const ariel::Graph &g) {
         if (g.getEdgeNegativity() == EdgeNegativity::NONE)
-            return "No negative cycle detected in the graph";
+            return NegativeCycleResult{CycleStatus::NO_CYCLE, std::vector<size_t>()};
 
         return detectNegativeCycle(g);
     }
@@ -19,52 +30,75 @@ namespace ariel {
     * Detects negative cycles in the given graph using the Bellman-ford algorithm.
     * will use different approaches according to graph type
     * @param g The graph in which to detect negative cycles.
-    * @return A string indicating the presence or absence of negative cycles.
+    * @return The negative cycle found, or NO_CYCLE.
     */
-    std::string DetectNegativeCycle::detectNegativeCycle(const ariel::Graph &g) {
+    NegativeCycleResult DetectNegativeCycle::detectNegativeCycle(const ariel::Graph &g) {
 
-        // for directed graph, add a vertex with an outgoing edge to each vertex
+        // for directed graph, run bellman-ford from a virtual vertex with an outgoing edge to each vertex
         if ( g.getGraphType()==GraphType::DIRECTED) {
-            // create a new graph g with new vertex
-            Graph new_Graph = g.addVertexWithEdges();
-
-            // run bellman-ford on the new graph from the new vertex
-            return bellmanFord(new_Graph, new_Graph.V() - 1);
-
+            return bellmanFordFromVirtualSource(g);
         }
 
         // for undirected graph run bellman-ford from each vertex
         else {
             for (size_t i = 0; i < g.V(); ++i) {
-                std::string cycle = bellmanFord(g, i);
-                if (cycle != "No negative cycle detected in the graph")
+                NegativeCycleResult cycle = bellmanFord(g, i);
+                if (cycle.status == CycleStatus::FOUND)
                     return cycle;
             }
         }
-        return "No negative cycle detected in the graph";
+        return NegativeCycleResult{CycleStatus::NO_CYCLE, std::vector<size_t>()};
     }
 
 
     // bellman ford algorithm for detecting negative cycles in the graphs
-    std::string DetectNegativeCycle::bellmanFord(const Graph &g, size_t source) {
+    NegativeCycleResult DetectNegativeCycle::bellmanFord(const Graph &g, size_t source) {
         // Initialize predecessors with a special value (-1) to indicate no predecessor
         std::vector<size_t> predecessors(g.V(), size_t(-1));
         // Initialize distances with infinity
-        std::vector<int> dist(g.V(), std::numeric_limits<int>::max());
+        std::vector<Distance> dist(g.V(), std::numeric_limits<Distance>::max());
         dist[source] = 0;
-        // Initialize a visited array to keep track of visited vertices
-        std::vector<bool> visited(g.V(), false);
 
-        size_t negativeCycleStart = g.V(); // Initialize to a value not in the graph
+        return relaxEdges(g, dist, predecessors);
+    }
+
+    /**
+     * Bellman-ford from a vertex outside the graph with an edge of weight VIRTUAL_SOURCE_WEIGHT
+     * to every vertex, so a negative cycle is found wherever it is.
+     * The extra vertex is never built: the first round of relaxation from it would only set every
+     * distance to VIRTUAL_SOURCE_WEIGHT, so the distances start there and the remaining |V| - 1
+     * rounds run on the graph itself. This gives the same cycle as running on the graph returned
+     * by Graph::addVertexWithEdges(), without copying the graph.
+     * @param g The directed graph in which to detect negative cycles.
+     * @return The negative cycle found, or NO_CYCLE.
+     */
+    NegativeCycleResult DetectNegativeCycle::bellmanFordFromVirtualSource(const Graph &g) {
+        // every vertex is reached straight from the virtual source, which is not a vertex of g
+        std::vector<size_t> predecessors(g.V(), size_t(-1));
+        std::vector<Distance> dist(g.V(), VIRTUAL_SOURCE_WEIGHT);
+
+        return relaxEdges(g, dist, predecessors);
+    }
+
+    /**
+     * Runs the |V| - 1 rounds of bellman-ford relaxation from the given initial distances,
+     * then looks for an edge that can still be relaxed.
+     * @param g The graph to relax the edges of.
+     * @param dist The initial distances, infinity for vertices that are not reached yet.
+     * @param predecessors The initial predecessors.
+     * @return The negative cycle found, or NO_CYCLE.
+     */
+    NegativeCycleResult DetectNegativeCycle::relaxEdges(const Graph &g, std::vector<Distance>& dist, std::vector<size_t>& predecessors) {
         // Iterating |V| - 1 times
         for (int i = 0; i < g.V() - 1; i++) {
             // Iterate through each edge in the graph
             for (size_t u = 0; u < g.V(); u++) {
-                for (size_t v = 0; v < g.V(); v++) {
+                for (Neighbor edge : g.neighbors(u)) {
                     // Perform relaxation on the edge u,v
-                    int weight_uv = g.getEdgeWeight(u, v);
-                    // Relax the edge if it exists and a shorter path is found
-                    if (weight_uv != 0 && dist[v] > weight_uv + dist[u] && dist[u] != std::numeric_limits<int>::max()) {
+                    size_t v = edge.vertex;
+                    Weight weight_uv = edge.weight;
+                    // Relax the edge if a shorter path is found
+                    if (dist[u] != std::numeric_limits<Distance>::max() && dist[v] > weight_uv + dist[u]) {
                         // in undirected graphs, use negative edge only once to relax
                         if(g.getGraphType()==GraphType::UNDIRECTED && predecessors[u] == v) {
                             continue;
@@ -81,50 +115,53 @@ namespace ariel {
     }
 
     // detect and construct the negative cycle in the graph if one was found
-    std::string DetectNegativeCycle::findNegativeCycle(const Graph& g, std::vector<int>& dist, std::vector<size_t>& predecessors) {
-        // Check for negative cycles
-        for (size_t v = 0; v < g.V(); ++v) {
-            for (size_t u = 0; u < g.V(); ++u) {
-                int weight_uv = g.getEdgeWeight(u, v);
-                    if (weight_uv != 0 && dist[u] != std::numeric_limits<int>::max() && dist[u] + weight_uv < dist[v]) {
-                        // ignore negative cycle with size 1 in undirected graphs
-                        if (g.getGraphType() == GraphType::UNDIRECTED && predecessors[u] == v){
-                            continue;
-                        }
-                        // Found a vertex involved in a negative cycle
-                        size_t cycleStart = u;
-                        std::string cycle = "Negative cycle found: ";
-                        size_t current = cycleStart;
-
-                        // Use a stack to reverse the cycle
-                        std::stack<size_t> cycleStack;
-
-                        // Traverse the cycle starting from the cycle start
-                        do {
-                            cycleStack.push(current);
-                            current = predecessors[current];
-                        } while (current != cycleStart);
-
-                        // Add the cycle start to complete the cycle
-                        cycle += std::to_string(cycleStart) + " -> ";
-
-                        // Construct the cycle string by popping elements from the stack
-                        while (!cycleStack.empty()) {
-                            current = cycleStack.top();
-                            cycleStack.pop();
-                            cycle += std::to_string(current) + " -> ";
-                        }
-
-                        // Remove the last " -> " from the string
-                        cycle.erase(cycle.length() - 4);
-
-                        return cycle;
+    NegativeCycleResult DetectNegativeCycle::findNegativeCycle(const Graph& g, std::vector<Distance>& dist, std::vector<size_t>& predecessors) {
+        // Check for negative cycles, keeping the edge (u,v) with the smallest v and then the smallest u,
+        // which is the first one a column by column scan of the matrix would report
+        size_t n = g.V();
+        size_t cycleStart = n;
+        size_t cycleEnd = n;
+        for (size_t u = 0; u < n; ++u) {
+            if (dist[u] == std::numeric_limits<Distance>::max())
+                continue;
+            for (Neighbor edge : g.neighbors(u)) {
+                size_t v = edge.vertex;
+                if (v >= cycleEnd)
+                    break;
+                if (dist[u] + edge.weight < dist[v]) {
+                    // ignore negative cycle with size 1 in undirected graphs
+                    if (g.getGraphType() == GraphType::UNDIRECTED && predecessors[u] == v) {
+                        continue;
                     }
+                    cycleStart = u;
+                    cycleEnd = v;
+                    break;
                 }
-
+            }
         }
-
-        return "No negative cycle detected in the graph";
+        if (cycleStart == n)
+            return NegativeCycleResult{CycleStatus::NO_CYCLE, std::vector<size_t>()};
+
+        // Found a vertex involved in a negative cycle
+        NegativeCycleResult result{CycleStatus::FOUND, std::vector<size_t>()};
+        size_t current = cycleStart;
+
+        // Use a stack to reverse the cycle
+        std::stack<size_t> cycleStack;
+
+        // Traverse the cycle starting from the cycle start
+        do {
+            cycleStack.push(current);
+            current = predecessors[current];
+        } while (current != cycleStart);
+
+        // Start with the cycle start, which the stack ends with, the vertices are reported with their original numbers
+        result.vertices.push_back(g.originalId(cycleStart));
+        while (!cycleStack.empty()) {
+            result.vertices.push_back(g.originalId(cycleStack.top()));
+            cycleStack.pop();
+        }
+        return result;
     }
 
 }// name space ariel
@@ -4,6 +4,7 @@
 #ifndef CPP_EX1_DETECTNEGATIVECYCLE_HPP
 #define CPP_EX1_DETECTNEGATIVECYCLE_HPP
 
+#include "AlgorithmResults.hpp"
 #include "Graph.hpp"
 #include "ShortestPath.hpp"
 #include <string>
@@ -13,11 +14,17 @@ namespace ariel {
     class DetectNegativeCycle {
     public:
         static std::string Execute(const Graph &g);
+        static NegativeCycleResult Find(const Graph &g);
 
     private:
-        static std::string detectNegativeCycle(const Graph &g);
-        static std::string bellmanFord(const Graph& g, size_t source);
-        static std::string findNegativeCycle(const Graph &g,  std::vector<int> &dist, std::vector<size_t> &predecessors);
+        // the weight of the edges from the virtual source to every vertex of a directed graph
+        static constexpr Distance VIRTUAL_SOURCE_WEIGHT = 10000;
+
+        static NegativeCycleResult detectNegativeCycle(const Graph &g);
+        static NegativeCycleResult bellmanFord(const Graph& g, size_t source);
+        static NegativeCycleResult bellmanFordFromVirtualSource(const Graph& g);
+        static NegativeCycleResult relaxEdges(const Graph& g, std::vector<Distance>& dist, std::vector<size_t>& predecessors);
+        static NegativeCycleResult findNegativeCycle(const Graph &g,  std::vector<Distance> &dist, std::vector<size_t> &predecessors);
     };
 }
 
@@ -1,49 +1,602 @@
 //written by Ido Avraham : 208699181
 //EMAIL: idoavraham086@gmail.com
 #include "Graph.hpp"
+#include "VertexOrdering.hpp"
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <utility>
 namespace ariel {
 
+    namespace {
+        /**
+         * The start of a graph file, followed by the CSR arrays: V+1 row offsets, E targets,
+         * E weights padded to 8 bytes, then the original vertex ids if the graph was reordered.
+         * Everything is written in the byte order and sizes of the machine, which are recorded
+         * so that a file from an incompatible build is rejected instead of misread.
+         */
+        struct GraphFileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;
+            uint32_t indexBytes;
+            uint32_t weightBytes;
+            uint8_t weightIsIntegral;
+            uint8_t graphType;
+            uint8_t edgeType;
+            uint8_t edgeNegativity;
+            uint8_t reordered;
+            uint8_t padding[3];
+            uint64_t numVertices;
+            uint64_t numEdges;
+        };
+        static_assert(sizeof(GraphFileHeader) == 48, "the arrays after the header must stay 8 byte aligned");
+
+        const char GRAPH_FILE_MAGIC[8] = {'A', 'R', 'I', 'E', 'L', 'G', 'R', 'F'};
+        const uint32_t GRAPH_FILE_VERSION = 1;
+        const uint32_t GRAPH_FILE_BYTE_ORDER = 0x01020304;
+
+        size_t paddedTo8(size_t bytes) {
+            return (bytes + 7) / 8 * 8;
+        }
+
+        template <typename T>
+        void writeArray(std::ofstream& out, const T* data, size_t count) {
+            out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+        }
+    }
+
     /**
     * Constructs an empty graph with default attributes.
     */
-    Graph::Graph() : numVertices(0), numEdges(0), graphType(GraphType::UNDIRECTED),
-                     edgeType(EdgeType::UNWEIGHTED), edgeNegativity(EdgeNegativity::NONE) {}
+    Graph::Graph() : layout(StorageLayout::SPARSE), subgraphBase(nullptr), numVertices(0), numEdges(0),
+                     properties(std::make_shared<PropertyCache>()),
+                     degreeStatistics(std::make_shared<StatisticsCache>()),
+                     propertyCountsValid(false), nonUnitEdges(0), negativeEdges(0), unmatchedEdges(0),
+                     inEdgeIndex(std::make_shared<InEdgeIndex>()) {}
     /**
     * Loads a graph from an adjacency matrix, setting properties such as number of vertices, number of edges,
     * graph type, edge type, and edge negativity based on the loaded data.
+    * The properties come from a single pass over the matrix, which then picks the storage layout
+    * according to the density of the matrix.
+    * @param matrix The adjacency matrix representing the graph.
+    * @throws std::invalid_argument if the matrix is not square.
+     */
+    void Graph::loadGraph(const std::vector<std::vector<Weight>>& matrix) {
+        if (!isValidGraph(matrix)) {
+            throw std::invalid_argument("Invalid graph: Graph is not valid.");
+        }
+
+        MatrixSummary summary = MatrixScanner::scan(matrix);
+        storeMatrix(matrix, chooseLayout(matrix.size(), summary.numEdges, !summary.weighted));
+        applySummary(summary);
+    }
+
+    /**
+    * Loads a graph from an adjacency matrix into the given storage layout.
+    * @param matrix The adjacency matrix representing the graph.
+    * @param storageLayout SPARSE for CSR storage, DENSE for a flat matrix, BITSET for a bit matrix,
+    * COMPRESSED for varint encoded rows.
+    * @throws std::invalid_argument if the matrix is not square, if BITSET is asked for a weighted graph,
+    *         or if SUBGRAPH is asked for.
+     */
+    void Graph::loadGraph(const std::vector<std::vector<Weight>>& matrix, StorageLayout storageLayout) {
+        if (!isValidGraph(matrix)) {
+            throw std::invalid_argument("Invalid graph: Graph is not valid.");
+        }
+
+        if (storageLayout == StorageLayout::SUBGRAPH) {
+            throw std::invalid_argument("Invalid graph: a matrix can't be loaded as a subgraph view.");
+        }
+        MatrixSummary summary = MatrixScanner::scan(matrix);
+        if (storageLayout == StorageLayout::BITSET && summary.weighted) {
+            throw std::invalid_argument("Invalid graph: bit packed storage needs an unweighted graph.");
+        }
+        storeMatrix(matrix, storageLayout);
+        applySummary(summary);
+    }
+
+    /**
+    * Loads a graph from an adjacency matrix the caller no longer needs, without copying it.
+    * When the dense layout is picked the rows of the matrix are adopted as they are (so they
+    * are not padded to cache lines), otherwise the matrix is freed once the graph is built.
+    * @param matrix The adjacency matrix representing the graph, left empty on success.
+    * @throws std::invalid_argument if the matrix is not square, the matrix is then left untouched.
+     */
+    void Graph::loadGraph(std::vector<std::vector<Weight>>&& matrix) {
+        if (!isValidGraph(matrix)) {
+            throw std::invalid_argument("Invalid graph: Graph is not valid.");
+        }
+
+        MatrixSummary summary = MatrixScanner::scan(matrix);
+        StorageLayout storageLayout = chooseLayout(matrix.size(), summary.numEdges, !summary.weighted);
+        if (storageLayout == StorageLayout::DENSE) {
+            clearGraph();
+            this->numVertices = matrix.size();
+            this->layout = StorageLayout::DENSE;
+            this->denseMatrix.adoptRows(std::move(matrix));
+        } else {
+            std::vector<std::vector<Weight>> consumed(std::move(matrix));
+            storeMatrix(consumed, storageLayout);
+        }
+        applySummary(summary);
+    }
+
+    /**
+    * Makes the graph a read-only view of the caller's adjacency matrix, nothing is copied.
+    * The matrix must stay alive and unchanged for as long as the graph (or a copy of it) is used.
     * @param matrix The adjacency matrix representing the graph.
     * @throws std::invalid_argument if the matrix is not square.
      */
-    void Graph::loadGraph(const std::vector<std::vector<int>>& matrix) {
+    void Graph::loadGraphView(const std::vector<std::vector<Weight>>& matrix) {
         if (!isValidGraph(matrix)) {
             throw std::invalid_argument("Invalid graph: Graph is not valid.");
         }
 
         clearGraph();
 
+        this->numVertices = matrix.size();
+        this->layout = StorageLayout::DENSE;
+        this->denseMatrix.borrowRows(matrix);
+        applySummary(MatrixScanner::scan(matrix));
+    }
+
+    /**
+    * Makes the graph a read-only view of a flat row-major buffer owned by the caller,
+    * with the same lifetime rules as the nested matrix view.
+    * @param cells The buffer, the weight of u->v is cells[u * rowStride + v].
+    * @param numVertices The number of vertices.
+    * @param rowStride The distance between the starts of two consecutive rows.
+    * @throws std::invalid_argument if rowStride is smaller than numVertices, or cells is null.
+     */
+    void Graph::loadGraphView(const Weight* cells, size_t numVertices, size_t rowStride) {
+        if (rowStride < numVertices || (cells == nullptr && numVertices > 0)) {
+            throw std::invalid_argument("Invalid graph: Graph is not valid.");
+        }
+
+        clearGraph();
+
+        this->numVertices = numVertices;
+        this->layout = StorageLayout::DENSE;
+        this->denseMatrix.borrowCells(cells, numVertices, rowStride);
+
+        std::vector<const Weight*> rows(numVertices);
+        for (size_t i = 0; i < numVertices; ++i)
+            rows[i] = cells + i * rowStride;
+        applySummary(MatrixScanner::scan(rows));
+    }
+
+    /**
+    * Writes the graph to a file that openMapped can read back without parsing it: the graph
+    * properties and sizes, then the edges in CSR form whatever the storage layout.
+    * @param path The file to create or overwrite.
+    * @throws std::runtime_error if the file can't be written.
+     */
+    void Graph::save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot create graph file: " + path);
+        }
+
+        GraphFileHeader header{};
+        std::memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+        header.version = GRAPH_FILE_VERSION;
+        header.byteOrder = GRAPH_FILE_BYTE_ORDER;
+        header.indexBytes = sizeof(size_t);
+        header.weightBytes = sizeof(Weight);
+        header.weightIsIntegral = std::is_integral<Weight>::value ? 1 : 0;
+        header.graphType = static_cast<uint8_t>(getGraphType());
+        header.edgeType = static_cast<uint8_t>(getEdgeType());
+        header.edgeNegativity = static_cast<uint8_t>(getEdgeNegativity());
+        header.reordered = isReordered() ? 1 : 0;
+        header.numVertices = numVertices;
+        header.numEdges = numEdges;
+        writeArray(out, &header, 1);
+
+        std::vector<size_t> offsets(numVertices + 1, 0);
+        for (size_t u = 0; u < numVertices; ++u)
+            offsets[u + 1] = offsets[u] + outDegree(u);
+        writeArray(out, offsets.data(), offsets.size());
+
+        // the targets and then the weights, one row at a time
+        std::vector<size_t> rowTargets;
+        std::vector<Weight> rowWeights;
+        for (size_t u = 0; u < numVertices; ++u) {
+            rowTargets.clear();
+            for (Neighbor edge : neighbors(u))
+                rowTargets.push_back(edge.vertex);
+            writeArray(out, rowTargets.data(), rowTargets.size());
+        }
+        for (size_t u = 0; u < numVertices; ++u) {
+            rowWeights.clear();
+            for (Neighbor edge : neighbors(u))
+                rowWeights.push_back(edge.weight);
+            writeArray(out, rowWeights.data(), rowWeights.size());
+        }
+        const char zeros[8] = {};
+        writeArray(out, zeros, paddedTo8(numEdges * sizeof(Weight)) - numEdges * sizeof(Weight));
+
+        if (isReordered())
+            writeArray(out, originalIds.data(), originalIds.size());
+
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Cannot write graph file: " + path);
+        }
+    }
+
+    /**
+    * Loads a graph written by save by mapping the file read-only: the graph reads its edges
+    * in place, so it can be queried right away, and processes that open the same file share
+    * its pages. The header, the file size, the rows (their offsets, and targets that are vertices
+    * in increasing order) and the vertex ids of a reordered graph are checked in one pass over
+    * them, the weights are trusted.
+    * The file stays mapped for as long as the graph (or a copy of it) uses it; the first
+    * modification copies the edges out of it.
+    * @param path The file to open.
+    * @throws std::runtime_error if the file can't be opened.
+    * @throws std::invalid_argument if the file is not a graph file written by a compatible build.
+     */
+    void Graph::openMapped(const std::string& path) {
+        std::shared_ptr<const MappedFile> file = std::make_shared<const MappedFile>(path);
+        GraphFileHeader header{};
+        if (file->size() < sizeof(header)) {
+            throw std::invalid_argument("Invalid graph file: " + path + " is too short.");
+        }
+        std::memcpy(&header, file->data(), sizeof(header));
+        if (std::memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) != 0
+            || header.version != GRAPH_FILE_VERSION) {
+            throw std::invalid_argument("Invalid graph file: " + path + " is not a graph file of this version.");
+        }
+        if (header.byteOrder != GRAPH_FILE_BYTE_ORDER || header.indexBytes != sizeof(size_t)
+            || header.weightBytes != sizeof(Weight)
+            || header.weightIsIntegral != (std::is_integral<Weight>::value ? 1 : 0)) {
+            throw std::invalid_argument("Invalid graph file: " + path + " was written for another weight type or machine.");
+        }
+        if (header.graphType > 1 || header.edgeType > 1 || header.edgeNegativity > 1
+            || header.numVertices >= file->size() || header.numEdges >= file->size()) {
+            throw std::invalid_argument("Invalid graph file: " + path + " has a corrupt header.");
+        }
+
+        size_t n = static_cast<size_t>(header.numVertices);
+        size_t e = static_cast<size_t>(header.numEdges);
+        size_t offsetsBytes = (n + 1) * sizeof(size_t);
+        size_t targetsBytes = e * sizeof(size_t);
+        size_t weightsBytes = paddedTo8(e * sizeof(Weight));
+        size_t idsBytes = header.reordered != 0 ? n * sizeof(size_t) : 0;
+        if (file->size() != sizeof(header) + offsetsBytes + targetsBytes + weightsBytes + idsBytes) {
+            throw std::invalid_argument("Invalid graph file: " + path + " is truncated.");
+        }
+        const uint8_t* cursor = file->data() + sizeof(header);
+        const size_t* offsets = reinterpret_cast<const size_t*>(cursor);
+        const size_t* targets = reinterpret_cast<const size_t*>(cursor + offsetsBytes);
+        const Weight* weights = reinterpret_cast<const Weight*>(cursor + offsetsBytes + targetsBytes);
+        if (offsets[0] != 0 || offsets[n] != e) {
+            throw std::invalid_argument("Invalid graph file: " + path + " has corrupt row offsets.");
+        }
+        // every row must lie between the offsets before and after it, and lead to vertices in increasing order
+        for (size_t i = 0; i < n; ++i) {
+            if (offsets[i] > offsets[i + 1]) {
+                throw std::invalid_argument("Invalid graph file: " + path + " has corrupt row offsets.");
+            }
+            for (size_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                if (targets[k] >= n || (k > offsets[i] && targets[k] <= targets[k - 1])) {
+                    throw std::invalid_argument("Invalid graph file: " + path + " has corrupt edge targets.");
+                }
+            }
+        }
+
+        // the ids of a reordered graph must be a permutation of its vertices
+        std::vector<size_t> fileOriginalIds;
+        std::vector<size_t> fileInternalIds;
+        if (header.reordered != 0) {
+            const size_t* ids = reinterpret_cast<const size_t*>(cursor + offsetsBytes + targetsBytes + weightsBytes);
+            fileOriginalIds.assign(ids, ids + n);
+            fileInternalIds.assign(n, n);
+            for (size_t i = 0; i < n; ++i) {
+                if (fileOriginalIds[i] >= n || fileInternalIds[fileOriginalIds[i]] != n) {
+                    throw std::invalid_argument("Invalid graph file: " + path + " has corrupt vertex ids.");
+                }
+                fileInternalIds[fileOriginalIds[i]] = i;
+            }
+        }
+
+        clearGraph();
+        this->numVertices = n;
+        this->numEdges = e;
+        this->layout = StorageLayout::SPARSE;
+        setProperties(static_cast<GraphType>(header.graphType), static_cast<EdgeType>(header.edgeType),
+                      static_cast<EdgeNegativity>(header.edgeNegativity));
+        this->originalIds = std::move(fileOriginalIds);
+        this->internalIds = std::move(fileInternalIds);
+        this->adjacency.borrowArrays(offsets, targets, weights, n, std::move(file));
+    }
+
+    /**
+     * Replaces the graph with a copy of the matrix in the given layout.
+     * The graph properties are left for the caller to set.
+     */
+    void Graph::storeMatrix(const std::vector<std::vector<Weight>>& matrix, StorageLayout storageLayout) {
+        clearGraph();
 
         this->numVertices = matrix.size();
-        this->adjacencyMatrix = matrix;
-        this->numEdges = 0;
+        this->layout = storageLayout;
+        switch (layout) {
+            case StorageLayout::DENSE:
+                this->denseMatrix.buildFromMatrix(matrix);
+                break;
+            case StorageLayout::BITSET:
+                this->bitMatrix.buildFromMatrix(matrix);
+                break;
+            case StorageLayout::DYNAMIC:
+                // built as CSR first, which convertLayout reads through neighbors()
+                this->layout = StorageLayout::SPARSE;
+                this->adjacency.buildFromMatrix(matrix);
+                convertLayout(StorageLayout::DYNAMIC);
+                break;
+            case StorageLayout::COMPRESSED:
+                this->layout = StorageLayout::SPARSE;
+                this->adjacency.buildFromMatrix(matrix);
+                compress();
+                break;
+            default:
+                this->adjacency.buildFromMatrix(matrix);
+        }
+    }
 
-        // Count edges and check for weighted and negative edges
-        for (size_t i = 0; i < numVertices; ++i) {
-            for (size_t j = 0; j < numVertices; ++j) {
-                if (adjacencyMatrix[i][j] != 0) {
-                    this->numEdges++;
-                    if (adjacencyMatrix[i][j] != 1) {
-                        this->edgeType = EdgeType::WEIGHTED;
-                        if (adjacencyMatrix[i][j] < 0) {
-                            this->edgeNegativity = EdgeNegativity::NEGATIVE;
-                        }
+    /**
+     * Sets the graph properties from the summary of the matrix it was loaded from.
+     */
+    void Graph::applySummary(const MatrixSummary& summary) {
+        this->numEdges = summary.numEdges;
+        setProperties(summary.symmetric ? GraphType::UNDIRECTED : GraphType::DIRECTED,
+                      summary.weighted ? EdgeType::WEIGHTED : EdgeType::UNWEIGHTED,
+                      summary.negative ? EdgeNegativity::NEGATIVE : EdgeNegativity::NONE);
+    }
+
+    /**
+     * Replaces the property cache with one that already holds the given properties.
+     */
+    void Graph::setProperties(GraphType graphType, EdgeType edgeType, EdgeNegativity edgeNegativity) {
+        std::shared_ptr<PropertyCache> cache = std::make_shared<PropertyCache>();
+        std::call_once(cache->weightsClassified, [&] {
+            cache->edgeType = edgeType;
+            cache->edgeNegativity = edgeNegativity;
+        });
+        std::call_once(cache->directionClassified, [&] { cache->graphType = graphType; });
+        this->properties = std::move(cache);
+    }
+
+    /**
+    * Loads an unweighted graph from a list of edges, without ever building a V x V matrix.
+    * The graph is stored in CSR form. Its properties are computed when they are first asked for:
+    * the edge type and negativity in O(E), the graph type in O(E log(max degree)).
+    * An undirected graph must list both directions of every edge.
+    * @param numVertices The number of vertices in the graph.
+    * @param edges The (source, target) pair of every edge.
+    * @throws std::invalid_argument if numVertices is SIZE_MAX, an endpoint is out of range or an edge appears twice.
+     */
+    void Graph::loadEdges(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges) {
+        loadEdgeList(numVertices, edges, std::vector<Weight>());
+    }
+
+    /**
+    * Loads a weighted graph from a list of edges, without ever building a V x V matrix.
+    * Edges of weight 0 are ignored, as they would be in an adjacency matrix.
+    * @param numVertices The number of vertices in the graph.
+    * @param edges The (source, target) pair of every edge.
+    * @param weights The weight of every edge, parallel to edges.
+    * @throws std::invalid_argument if numVertices is SIZE_MAX, an endpoint is out of range, an edge
+    *         appears twice, or there isn't exactly one weight per edge.
+     */
+    void Graph::loadEdges(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges,
+                          const std::vector<Weight>& weights) {
+        if (weights.size() != edges.size()) {
+            throw std::invalid_argument("Invalid graph: every edge needs exactly one weight.");
+        }
+        loadEdgeList(numVertices, edges, weights);
+    }
+
+    /**
+     * Validates the endpoints and builds the CSR arrays of an edge list.
+     * @param weights The weight of every edge, or empty if every edge weighs 1.
+     */
+    void Graph::loadEdgeList(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges,
+                             const std::vector<Weight>& weights) {
+        // the CSR arrays hold one more row offset than vertices
+        if (numVertices == std::numeric_limits<size_t>::max()) {
+            throw std::invalid_argument("Invalid graph: too many vertices.");
+        }
+        for (const auto& edge : edges) {
+            if (edge.first >= numVertices || edge.second >= numVertices) {
+                throw std::invalid_argument("Invalid graph: edge endpoint out of range.");
+            }
+        }
+
+        // build aside first, so a rejected edge list leaves the graph untouched
+        CsrAdjacency built;
+        built.buildFromEdges(numVertices, edges, weights);
+
+        clearGraph();
+
+        this->numVertices = numVertices;
+        this->numEdges = built.E();
+        this->layout = StorageLayout::SPARSE;
+        this->adjacency = std::move(built);
+    }
+
+    /**
+    * Loads a graph from CSR arrays built by the caller, see StreamingGraphBuilder. The arrays
+    * are moved in as they are, the graph properties are computed from them when first asked for.
+    * @param built The edges, every row sorted by target with no edge twice and no edge of weight 0.
+     */
+    void Graph::loadAdjacency(CsrAdjacency built) {
+        clearGraph();
+
+        this->numVertices = built.V();
+        this->numEdges = built.E();
+        this->layout = StorageLayout::SPARSE;
+        this->adjacency = std::move(built);
+    }
+
+    /**
+    * Makes the graph a read-only view of the subgraph of parent induced by a set of vertices,
+    * nothing is copied. See the overload with an edge predicate.
+     */
+    void Graph::loadSubgraphView(const Graph& parent, const std::vector<bool>& vertices) {
+        loadSubgraphView(parent, vertices, SubgraphFilter::EdgePredicate());
+    }
+
+    /**
+    * Makes the graph a read-only view of a subgraph of parent (StorageLayout::SUBGRAPH): the vertices
+    * set in the bitmap, and the edges between them that keepEdge accepts. The edges are read from
+    * parent as the algorithms walk them, so making the view costs O(V) for the parent's V, plus a
+    * pass over the edges of the kept vertices to count them.
+    * The kept vertices are numbered 0..k-1 in the view, in the order of their numbers in parent
+    * (so the view answers like a graph loaded with the matrix of the subgraph), parentId translates back.
+    * Inside, the view keeps them in the order of the graph it reads, so its rows are sorted like
+    * that graph's; a view of a reordered graph is reordered too, and maps the numbers as reorder does.
+    * A view of a view reads the edges of the first graph directly.
+    * parent (and the graph it is a view of) must stay alive and unchanged for as long as the view
+    * (or a copy of it) is used. The first modification of the view copies its edges.
+    * @param parent The graph to take the subgraph of.
+    * @param vertices Whether each vertex of parent, in the numbering the algorithms take, is kept.
+    * @param keepEdge Called with the source, target and weight of an edge between kept vertices
+    *        (numbered as in parent), the edge is kept if it returns true. Empty to keep every edge.
+    * @throws std::invalid_argument if there isn't one flag per vertex of parent, or if the graph is
+    *         parent itself or the graph parent is a view of.
+     */
+    void Graph::loadSubgraphView(const Graph& parent, const std::vector<bool>& vertices,
+                                 const SubgraphFilter::EdgePredicate& keepEdge) {
+        if (vertices.size() != parent.V()) {
+            throw std::invalid_argument("Invalid subgraph: there must be one flag per vertex of the graph.");
+        }
+        const Graph* base = parent.layout == StorageLayout::SUBGRAPH ? parent.subgraphBase : &parent;
+        if (base == this || &parent == this) {
+            throw std::invalid_argument("Invalid subgraph: a graph can't be a view of itself.");
+        }
+
+        // the number every kept vertex of base has in the view, in the order parent numbers them
+        std::vector<size_t> viewIds(base->V(), static_cast<size_t>(SubgraphFilter::NO_VERTEX));
+        std::shared_ptr<SubgraphFilter> filter = std::make_shared<SubgraphFilter>();
+        for (size_t v = 0; v < vertices.size(); ++v) {
+            if (!vertices[v])
+                continue;
+            size_t internal = parent.internalId(v);
+            size_t baseId = parent.layout == StorageLayout::SUBGRAPH ? parent.subgraphFilter->baseIds[internal]
+                                                                     : internal;
+            viewIds[baseId] = filter->parentIds.size();
+            filter->parentIds.push_back(v);
+        }
+        // the view keeps the vertices in the order of base, so its rows are sorted like the rows of
+        // base, and numbers them as parent does through the permutation of a reordered graph
+        std::vector<size_t> renumberedIds;
+        bool renumbered = false;
+        filter->localIds.assign(base->V(), static_cast<size_t>(SubgraphFilter::NO_VERTEX));
+        for (size_t b = 0; b < base->V(); ++b) {
+            if (viewIds[b] == SubgraphFilter::NO_VERTEX)
+                continue;
+            filter->localIds[b] = filter->baseIds.size();
+            renumbered = renumbered || viewIds[b] != filter->baseIds.size();
+            filter->baseIds.push_back(b);
+            renumberedIds.push_back(viewIds[b]);
+        }
+
+        // the filter is called with vertices of base, keepEdge takes them as parent numbers them
+        if (parent.layout == StorageLayout::SUBGRAPH) {
+            std::shared_ptr<const SubgraphFilter> outer = parent.subgraphFilter;
+            if (outer->keepEdge || keepEdge) {
+                std::vector<size_t> outerIds = parent.originalIds;
+                filter->keepEdge = [outer, outerIds, keepEdge](size_t u, size_t v, Weight weight) -> bool {
+                    if (outer->keepEdge && !outer->keepEdge(u, v, weight))
+                        return false;
+                    if (!keepEdge)
+                        return true;
+                    size_t from = outer->localIds[u];
+                    size_t to = outer->localIds[v];
+                    return outerIds.empty() ? keepEdge(from, to, weight)
+                                            : keepEdge(outerIds[from], outerIds[to], weight);
+                };
+            }
+        } else if (keepEdge) {
+            filter->keepEdge = [base, keepEdge](size_t u, size_t v, Weight weight) {
+                return keepEdge(base->originalId(u), base->originalId(v), weight);
+            };
+        }
+
+        clearGraph();
+        this->numVertices = filter->baseIds.size();
+        this->layout = StorageLayout::SUBGRAPH;
+        this->subgraphBase = base;
+        this->subgraphFilter = std::move(filter);
+        if (renumbered) {
+            this->originalIds = std::move(renumberedIds);
+            this->internalIds.assign(numVertices, 0);
+            for (size_t i = 0; i < numVertices; ++i)
+                this->internalIds[originalIds[i]] = i;
+        }
+        for (size_t u = 0; u < numVertices; ++u)
+            this->numEdges += neighbors(u).size();
+    }
+
+    /**
+     * Picks the layout that needs less memory: a CSR edge costs a target index and a weight,
+     * a dense cell costs a weight whether the edge exists or not, and a bit matrix cell
+     * (possible only when every edge weighs 1) costs a single bit.
+     */
+    StorageLayout Graph::chooseLayout(size_t numVertices, size_t numEdges, bool unweighted) {
+        size_t cellsPerLine = DenseMatrix::CACHE_LINE_BYTES / sizeof(Weight);
+        size_t stride = (numVertices + cellsPerLine - 1) / cellsPerLine * cellsPerLine;
+        size_t denseBytes = numVertices * stride * sizeof(Weight);
+        size_t sparseBytes = (numVertices + 1) * sizeof(size_t) + numEdges * (sizeof(size_t) + sizeof(Weight));
+        size_t bitBytes = numVertices * ((numVertices + 63) / 64 * sizeof(uint64_t) + sizeof(size_t));
+
+        if (unweighted && bitBytes <= denseBytes && bitBytes <= sparseBytes)
+            return StorageLayout::BITSET;
+        return denseBytes <= sparseBytes ? StorageLayout::DENSE : StorageLayout::SPARSE;
+    }
+
+    /**
+     * Computes the edge type and edge negativity from the stored edges, in O(E) for CSR storage.
+     * The scan stops at the first negative edge.
+     */
+    void Graph::classifyWeights(PropertyCache& cache) const {
+        cache.edgeType = EdgeType::UNWEIGHTED;
+        cache.edgeNegativity = EdgeNegativity::NONE;
+        for (size_t u = 0; u < numVertices; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                if (edge.weight != 1) {
+                    cache.edgeType = EdgeType::WEIGHTED;
+                    if (edge.weight < 0) {
+                        cache.edgeNegativity = EdgeNegativity::NEGATIVE;
+                        return;
                     }
                 }
             }
         }
+    }
 
-        // Check if graph is directed
-        if (!isSymmetricMatrix(matrix)) {
-            this->graphType = GraphType::DIRECTED;
+    /**
+     * Counts the degree statistics in one pass over the edges, O(V+E).
+     */
+    void Graph::countDegrees(DegreeStatistics& statistics) const {
+        statistics = DegreeStatistics{0, 0, 0, 0, 0};
+        std::vector<size_t> inDegrees(numVertices, 0);
+        for (size_t u = 0; u < numVertices; ++u) {
+            statistics.maxOutDegree = std::max(statistics.maxOutDegree, outDegree(u));
+            for (Neighbor edge : neighbors(u)) {
+                ++inDegrees[edge.vertex];
+                statistics.selfLoops += edge.vertex == u ? 1u : 0u;
+            }
+        }
+        for (size_t degree : inDegrees)
+            statistics.maxInDegree = std::max(statistics.maxInDegree, degree);
+        if (numVertices > 0) {
+            double vertices = static_cast<double>(numVertices);
+            statistics.averageDegree = static_cast<double>(numEdges) / vertices;
+            statistics.density = static_cast<double>(numEdges) / (vertices * vertices);
         }
     }
 
@@ -53,13 +606,23 @@ namespace ariel {
     void Graph::clearGraph() {
         this->numVertices = 0;
         this->numEdges = 0;
-        this->adjacencyMatrix.clear();
-        this->graphType = GraphType::UNDIRECTED;
-        this->edgeType = EdgeType::UNWEIGHTED;
-        this->edgeNegativity = EdgeNegativity::NONE;
+        this->adjacency.clear();
+        this->denseMatrix.clear();
+        this->bitMatrix.clear();
+        this->adjacencyLists.clear();
+        this->compressedAdjacency.clear();
+        dropSubgraph();
+        this->originalIds.clear();
+        this->internalIds.clear();
+        this->layout = StorageLayout::SPARSE;
+        this->propertyCountsValid = false;
+        // copies made before the reload keep the properties and the index of the old edges
+        this->properties = std::make_shared<PropertyCache>();
+        this->degreeStatistics = std::make_shared<StatisticsCache>();
+        this->inEdgeIndex = std::make_shared<InEdgeIndex>();
     }
 
-    bool Graph::isValidGraph(const std::vector<std::vector<int>>& adjacencyMatrix) {
+    bool Graph::isValidGraph(const std::vector<std::vector<Weight>>& adjacencyMatrix) {
         for(const auto& row : adjacencyMatrix) {
             if (row.size() != adjacencyMatrix.size()) {
                 return false;
@@ -68,11 +631,25 @@ namespace ariel {
         return true;
     }
 
-    bool Graph::isSymmetricMatrix(const std::vector<std::vector<int>>& matrix) {
-        size_t n = matrix.size();
-        for (size_t i = 0; i < n; ++i) {
-            for (size_t j = 0; j < n; ++j) {
-                if (matrix[i][j] != matrix[j][i]) {
+    /**
+     * The graph is symmetric iff every edge u->v has a reverse edge v->u with the same weight.
+     */
+    bool Graph::isSymmetric() const {
+        if (layout == StorageLayout::DENSE) {
+            // compare the upper triangle against the lower one, each pair once
+            for (size_t i = 0; i < numVertices; ++i) {
+                const Weight* row = denseMatrix.row(i);
+                for (size_t j = i + 1; j < numVertices; ++j) {
+                    if (row[j] != denseMatrix.weight(j, i)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+        for (size_t u = 0; u < numVertices; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                if (getEdgeWeight(edge.vertex, u) != edge.weight) {
                     return false;
                 }
             }
@@ -80,48 +657,592 @@ namespace ariel {
         return true;
     }
 
+    /**
+    * Adds the edge u->v with weight 1. An undirected graph stays undirected only once the
+    * edge v->u is added as well.
+    * @throws std::invalid_argument if a vertex is out of range or the edge already exists.
+     */
+    void Graph::addEdge(size_t u, size_t v) {
+        addEdge(u, v, 1);
+    }
+
+    /**
+    * Adds the edge u->v with the given weight.
+    * @throws std::invalid_argument if a vertex is out of range, the edge already exists or the weight is 0.
+     */
+    void Graph::addEdge(size_t u, size_t v, Weight weight) {
+        checkVertices(u, v);
+        if (weight == 0) {
+            throw std::invalid_argument("Invalid edge: an edge can't weigh 0.");
+        }
+        if (getEdgeWeight(u, v) != 0) {
+            throw std::invalid_argument("Invalid edge: the edge already exists.");
+        }
+        updateEdge(u, v, weight);
+    }
+
+    /**
+    * Removes the edge u->v.
+    * @throws std::invalid_argument if a vertex is out of range or there is no such edge.
+     */
+    void Graph::removeEdge(size_t u, size_t v) {
+        checkVertices(u, v);
+        if (getEdgeWeight(u, v) == 0) {
+            throw std::invalid_argument("Invalid edge: there is no such edge.");
+        }
+        updateEdge(u, v, 0);
+    }
+
+    /**
+    * Sets the weight of the edge u->v, adding the edge if it is missing. A weight of 0 removes it.
+    * @throws std::invalid_argument if a vertex is out of range.
+     */
+    void Graph::setWeight(size_t u, size_t v, Weight weight) {
+        checkVertices(u, v);
+        updateEdge(u, v, weight);
+    }
+
+    /**
+    * Adds a vertex with no edges.
+    * O(1) amortized on sparse graphs, a dense or bit matrix is copied into a bigger one.
+    * @return The number of the new vertex.
+     */
+    size_t Graph::addVertex() {
+        switch (layout) {
+            case StorageLayout::DENSE:
+                this->denseMatrix = denseMatrix.resized(numVertices + 1);
+                break;
+            case StorageLayout::BITSET:
+                this->bitMatrix = bitMatrix.resized(numVertices + 1);
+                break;
+            case StorageLayout::SPARSE:
+            case StorageLayout::COMPRESSED:
+            case StorageLayout::SUBGRAPH:
+                convertLayout(StorageLayout::DYNAMIC);
+                this->adjacencyLists.addVertex();
+                break;
+            default:
+                this->adjacencyLists.addVertex();
+        }
+        if (isReordered()) {
+            this->originalIds.push_back(numVertices);
+            this->internalIds.push_back(numVertices);
+        }
+        // a vertex with no edges leaves the graph properties as they are, but not the statistics
+        this->degreeStatistics = std::make_shared<StatisticsCache>();
+        this->inEdgeIndex = std::make_shared<InEdgeIndex>();
+        return this->numVertices++;
+    }
+
+    /**
+    * Renumbers the vertices for memory locality, see VertexOrdering for the orders.
+    * The graph keeps the original number of every vertex: every method of the graph takes and
+    * returns the new numbers, and originalId and internalId translate between the two.
+    * The algorithms take and report the original numbers.
+    * Costs O(V + E log(max degree)) (O(V^2) for a dense matrix) and copies a view.
+    * @param order The new order, ORIGINAL goes back to the original numbering.
+     */
+    void Graph::reorder(VertexOrder order) {
+        std::vector<size_t> newOrder = VertexOrdering::Execute(*this, order);
+
+        // newNumber[v] is the number of the vertex now numbered v
+        std::vector<size_t> newNumber(numVertices);
+        for (size_t i = 0; i < numVertices; ++i)
+            newNumber[newOrder[i]] = i;
+
+        std::vector<std::pair<size_t, size_t>> edges;
+        std::vector<Weight> weights;
+        edges.reserve(numEdges);
+        weights.reserve(numEdges);
+        for (size_t u = 0; u < numVertices; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                edges.emplace_back(newNumber[u], newNumber[edge.vertex]);
+                weights.push_back(edge.weight);
+            }
+        }
+
+        switch (layout) {
+            case StorageLayout::DENSE: {
+                DenseMatrix renumbered(numVertices);
+                for (size_t e = 0; e < edges.size(); ++e)
+                    renumbered.setWeight(edges[e].first, edges[e].second, weights[e]);
+                this->denseMatrix = std::move(renumbered);
+                break;
+            }
+            case StorageLayout::BITSET: {
+                BitMatrix renumbered(numVertices);
+                for (const auto& edge : edges)
+                    renumbered.setEdge(edge.first, edge.second, true);
+                this->bitMatrix = std::move(renumbered);
+                break;
+            }
+            default:
+                this->adjacency.buildFromEdges(numVertices, edges, weights);
+                if (layout == StorageLayout::DYNAMIC) {
+                    this->layout = StorageLayout::SPARSE;
+                    convertLayout(StorageLayout::DYNAMIC);
+                } else if (layout == StorageLayout::COMPRESSED) {
+                    this->layout = StorageLayout::SPARSE;
+                    compress();
+                } else if (layout == StorageLayout::SUBGRAPH) {
+                    // a reordered view keeps its renumbered edges in CSR form
+                    this->layout = StorageLayout::SPARSE;
+                    dropSubgraph();
+                }
+        }
+
+        if (order == VertexOrder::ORIGINAL) {
+            this->originalIds.clear();
+            this->internalIds.clear();
+        } else {
+            std::vector<size_t> renumberedIds(numVertices);
+            for (size_t i = 0; i < numVertices; ++i)
+                renumberedIds[i] = originalId(newOrder[i]);
+            this->originalIds = std::move(renumberedIds);
+            this->internalIds.assign(numVertices, 0);
+            for (size_t i = 0; i < numVertices; ++i)
+                this->internalIds[originalIds[i]] = i;
+        }
+        this->inEdgeIndex = std::make_shared<InEdgeIndex>();
+    }
+
+    void Graph::checkVertices(size_t u, size_t v) const {
+        if (u >= numVertices || v >= numVertices) {
+            throw std::invalid_argument("Invalid edge: vertex out of range.");
+        }
+    }
+
+    /**
+     * Stores the new weight of u->v and updates the graph properties from their counts,
+     * in O(1) for a dense or bit matrix and O(degree) for a sparse graph.
+     * A sparse or compressed graph, or a subgraph view, is moved to per-vertex edge vectors first, and a bit matrix
+     * that gets a weight other than 1 to whichever of the other layouts takes less memory.
+     */
+    void Graph::updateEdge(size_t u, size_t v, Weight weight) {
+        Weight previous = getEdgeWeight(u, v);
+        if (previous == weight)
+            return;
+
+        // convert before counting, so the lookups of the reverse edges don't decode compressed rows
+        if (layout == StorageLayout::SPARSE || layout == StorageLayout::COMPRESSED || layout == StorageLayout::SUBGRAPH
+            || (layout == StorageLayout::BITSET && weight != 1 && weight != 0)) {
+            StorageLayout target = chooseLayout(numVertices, numEdges + 1, false);
+            convertLayout(target == StorageLayout::DENSE ? StorageLayout::DENSE : StorageLayout::DYNAMIC);
+        }
+        countProperties();
+        Weight reverse = getEdgeWeight(v, u);
+
+        switch (layout) {
+            case StorageLayout::DENSE:
+                this->denseMatrix.setWeight(u, v, weight);
+                break;
+            case StorageLayout::BITSET:
+                this->bitMatrix.setEdge(u, v, weight != 0);
+                break;
+            default:
+                this->adjacencyLists.setWeight(u, v, weight);
+        }
+
+        // take the old edge out of the counts and put the new one in
+        if (previous != 0) {
+            --this->numEdges;
+            this->nonUnitEdges -= previous != 1 ? 1u : 0u;
+            this->negativeEdges -= previous < 0 ? 1u : 0u;
+        }
+        if (weight != 0) {
+            ++this->numEdges;
+            this->nonUnitEdges += weight != 1 ? 1u : 0u;
+            this->negativeEdges += weight < 0 ? 1u : 0u;
+        }
+        if (u != v) {
+            // an edge is unmatched when the reverse edge is missing or weighs differently
+            auto unmatched = [](Weight w, Weight reverseWeight) -> size_t {
+                return w != 0 && w != reverseWeight ? 1u : 0u;
+            };
+            this->unmatchedEdges -= unmatched(previous, reverse) + unmatched(reverse, previous);
+            this->unmatchedEdges += unmatched(weight, reverse) + unmatched(reverse, weight);
+        }
+        applyPropertyCounts();
+        this->degreeStatistics = std::make_shared<StatisticsCache>();
+        this->inEdgeIndex = std::make_shared<InEdgeIndex>();
+    }
+
+    /**
+     * Counts the non unit, negative and unmatched edges, once, before the first modification
+     * of the graph. Loading only keeps whether these counts are zero.
+     */
+    void Graph::countProperties() {
+        if (propertyCountsValid)
+            return;
+        this->nonUnitEdges = 0;
+        this->negativeEdges = 0;
+        this->unmatchedEdges = 0;
+        for (size_t u = 0; u < numVertices; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                this->nonUnitEdges += edge.weight != 1 ? 1u : 0u;
+                this->negativeEdges += edge.weight < 0 ? 1u : 0u;
+                if (edge.vertex != u && getEdgeWeight(edge.vertex, u) != edge.weight)
+                    ++this->unmatchedEdges;
+            }
+        }
+        this->propertyCountsValid = true;
+    }
+
+    void Graph::applyPropertyCounts() {
+        setProperties(unmatchedEdges > 0 ? GraphType::DIRECTED : GraphType::UNDIRECTED,
+                      nonUnitEdges > 0 ? EdgeType::WEIGHTED : EdgeType::UNWEIGHTED,
+                      negativeEdges > 0 ? EdgeNegativity::NEGATIVE : EdgeNegativity::NONE);
+    }
+
+    /**
+     * Moves the edges into another storage layout, DENSE or DYNAMIC.
+     */
+    void Graph::convertLayout(StorageLayout storageLayout) {
+        if (storageLayout == StorageLayout::DENSE) {
+            DenseMatrix converted(numVertices);
+            for (size_t u = 0; u < numVertices; ++u) {
+                for (Neighbor edge : neighbors(u))
+                    converted.setWeight(u, edge.vertex, edge.weight);
+            }
+            this->denseMatrix = std::move(converted);
+        } else {
+            AdjacencyLists converted(numVertices);
+            for (size_t u = 0; u < numVertices; ++u)
+                converted.assignRow(u, neighbors(u));
+            this->adjacencyLists = std::move(converted);
+            this->denseMatrix.clear();
+        }
+        this->adjacency.clear();
+        this->bitMatrix.clear();
+        this->compressedAdjacency.clear();
+        dropSubgraph();
+        this->layout = storageLayout;
+    }
+
+    /**
+     * Lets go of the graph a subgraph view reads, once the view is reloaded or has copied its edges.
+     */
+    void Graph::dropSubgraph() {
+        this->subgraphBase = nullptr;
+        this->subgraphFilter.reset();
+    }
+
+    /**
+     * Moves the edges into varint encoded rows (StorageLayout::COMPRESSED), see CompressedAdjacency.
+     * The graph is read-only in that layout: it moves to per-vertex edge vectors when it is modified.
+     * Takes less memory the closer the targets of a row are, so it pays to reorder the graph first.
+     */
+    void Graph::compress() {
+        if (layout == StorageLayout::COMPRESSED)
+            return;
+        bool unitWeights = true;
+        for (size_t u = 0; u < numVertices && unitWeights; ++u) {
+            for (Neighbor edge : neighbors(u))
+                unitWeights = unitWeights && edge.weight == 1;
+        }
+
+        CompressedAdjacency compressed(unitWeights);
+        for (size_t u = 0; u < numVertices; ++u)
+            compressed.appendRow(neighbors(u));
+        this->compressedAdjacency = std::move(compressed);
+        this->adjacency.clear();
+        this->denseMatrix.clear();
+        this->bitMatrix.clear();
+        this->adjacencyLists.clear();
+        dropSubgraph();
+        this->layout = StorageLayout::COMPRESSED;
+        this->inEdgeIndex = std::make_shared<InEdgeIndex>();
+    }
+
+    /**
+     * Moves the edges to per-vertex edge vectors (StorageLayout::DYNAMIC), the layout a sparse graph
+     * is updated in. Copies of a graph in that layout share their rows until one of them changes a
+     * row, so a copy costs O(V / AdjacencyLists::ROWS_PER_BLOCK), see VersionedGraph.
+     */
+    void Graph::makeEditable() {
+        if (layout != StorageLayout::DYNAMIC)
+            convertLayout(StorageLayout::DYNAMIC);
+    }
+
     void Graph::printGraph() const {
         std::cout << "Graph with " << numVertices << " vertices and " << numEdges << " edges." << std::endl;
     }
 
     
+    /**
+     * Whether the graph is directed, checked on the first call when loading didn't tell,
+     * in O(E log(max degree)) for a sparse graph. Safe to call from several threads at once,
+     * as are the other property getters.
+     */
     GraphType Graph::getGraphType() const {
-        return graphType;
+        PropertyCache& cache = *properties;
+        std::call_once(cache.directionClassified, [this, &cache] {
+            cache.graphType = isSymmetric() ? GraphType::UNDIRECTED : GraphType::DIRECTED;
+        });
+        return cache.graphType;
     }
 
     EdgeType Graph::getEdgeType() const {
-        return edgeType;
+        PropertyCache& cache = *properties;
+        std::call_once(cache.weightsClassified, [this, &cache] { classifyWeights(cache); });
+        return cache.edgeType;
     }
 
     EdgeNegativity Graph::getEdgeNegativity() const {
-        return edgeNegativity;
+        PropertyCache& cache = *properties;
+        std::call_once(cache.weightsClassified, [this, &cache] { classifyWeights(cache); });
+        return cache.edgeNegativity;
+    }
+
+    /**
+     * The maximum out and in degree, the average degree, the density and the number of self loops,
+     * counted on the first call in O(V+E) and kept until the edges or the vertices change.
+     */
+    DegreeStatistics Graph::getDegreeStatistics() const {
+        StatisticsCache& cache = *degreeStatistics;
+        std::call_once(cache.counted, [this, &cache] { countDegrees(cache.statistics); });
+        return cache.statistics;
+    }
+
+    StorageLayout Graph::getStorageLayout() const {
+        return layout;
+    }
+
+    /**
+     * Whether the graph reads memory owned by the caller, see loadGraphView.
+     */
+    bool Graph::isView() const {
+        return (layout == StorageLayout::DENSE && denseMatrix.isBorrowed()) || layout == StorageLayout::SUBGRAPH;
+    }
+
+    /**
+     * Whether the graph reads its edges from a mapped file, see openMapped.
+     */
+    bool Graph::isMapped() const {
+        return layout == StorageLayout::SPARSE && adjacency.isBorrowed();
+    }
+
+    bool Graph::isReordered() const {
+        return !originalIds.empty();
+    }
+
+    /**
+     * The number vertex v had before the graph was reordered.
+     */
+    size_t Graph::originalId(size_t v) const {
+        return originalIds.empty() ? v : originalIds[v];
+    }
+
+    /**
+     * The number of the vertex that was numbered v before the graph was reordered.
+     */
+    size_t Graph::internalId(size_t v) const {
+        return internalIds.empty() ? v : internalIds[v];
+    }
+
+    /**
+     * The number vertex v of a subgraph view (numbered as the algorithms take it) has in the graph
+     * the view was made of, v itself for a graph that isn't a subgraph view.
+     */
+    size_t Graph::parentId(size_t v) const {
+        return layout == StorageLayout::SUBGRAPH ? subgraphFilter->parentIds[v] : v;
     }
 
     size_t Graph::V() const {
         return numVertices;
     }
 
-    int Graph::getEdgeWeight(size_t u, size_t v) const {
-        return adjacencyMatrix[u][v];
+    size_t Graph::E() const {
+        return numEdges;
     }
 
-    Graph Graph::getReversedGraph() const {
-        // Create a new graph
-        Graph reversedGraph;
+    Weight Graph::getEdgeWeight(size_t u, size_t v) const {
+        switch (layout) {
+            case StorageLayout::DENSE:
+                return denseMatrix.weight(u, v);
+            case StorageLayout::BITSET:
+                return bitMatrix.hasEdge(u, v) ? 1 : 0;
+            case StorageLayout::DYNAMIC:
+                return adjacencyLists.weight(u, v);
+            case StorageLayout::COMPRESSED:
+                return compressedAdjacency.weight(u, v);
+            case StorageLayout::SUBGRAPH: {
+                size_t baseU = subgraphFilter->baseIds[u];
+                size_t baseV = subgraphFilter->baseIds[v];
+                Weight weight = subgraphBase->getEdgeWeight(baseU, baseV);
+                return weight != 0 && subgraphFilter->keeps(baseU, baseV, weight) ? weight : 0;
+            }
+            default:
+                return adjacency.weight(u, v);
+        }
+    }
 
-        // Reverse the adjacency matrix
-        std::vector<std::vector<int>> reversedAdjacencyMatrix(numVertices, std::vector<int>(numVertices, 0));
+    size_t Graph::outDegree(size_t u) const {
+        switch (layout) {
+            case StorageLayout::DENSE:
+                return denseMatrix.degree(u);
+            case StorageLayout::BITSET:
+                return bitMatrix.degree(u);
+            case StorageLayout::DYNAMIC:
+                return adjacencyLists.degree(u);
+            case StorageLayout::COMPRESSED:
+                return compressedAdjacency.degree(u);
+            case StorageLayout::SUBGRAPH:
+                return subgraphEdges(u, false).size();
+            default:
+                return adjacency.degree(u);
+        }
+    }
 
-        for (size_t i = 0; i < numVertices; ++i) {
-            for (size_t j = 0; j < numVertices; ++j) {
-                if (adjacencyMatrix[i][j] != 0) {
-                    reversedAdjacencyMatrix[j][i] = adjacencyMatrix[i][j];
+    /**
+     * Returns the outgoing edges of u in increasing order of the target vertex.
+     * Iterating over all the neighbors of every vertex costs O(V+E).
+     */
+    NeighborRange Graph::neighbors(size_t u) const {
+        switch (layout) {
+            case StorageLayout::DENSE:
+                return denseMatrix.neighbors(u);
+            case StorageLayout::BITSET:
+                return bitMatrix.neighbors(u);
+            case StorageLayout::DYNAMIC:
+                return adjacencyLists.neighbors(u);
+            case StorageLayout::COMPRESSED:
+                return compressedAdjacency.neighbors(u);
+            case StorageLayout::SUBGRAPH:
+                return subgraphEdges(u, false);
+            default:
+                return adjacency.neighbors(u);
+        }
+    }
+
+    /**
+     * The edges out of (or with incoming, into) vertex u of a subgraph view: the edges of the
+     * vertex behind u in the base graph, filtered as the view is walked. Counting them costs O(degree).
+     */
+    NeighborRange Graph::subgraphEdges(size_t u, bool incoming) const {
+        size_t baseU = subgraphFilter->baseIds[u];
+        NeighborRange edges = incoming ? subgraphBase->inNeighbors(baseU) : subgraphBase->neighbors(baseU);
+        return edges.filtered(subgraphFilter.get(), baseU, incoming);
+    }
+
+    size_t Graph::inDegree(size_t v) const {
+        switch (layout) {
+            case StorageLayout::DENSE:
+                return denseMatrix.inDegree(v);
+            case StorageLayout::BITSET:
+                return bitMatrix.inDegree(v);
+            case StorageLayout::SUBGRAPH:
+                return subgraphEdges(v, true).size();
+            default:
+                return sparseInEdges().degree(v);
+        }
+    }
+
+    /**
+     * Returns the incoming edges of v (each one as the vertex it comes from and its weight),
+     * in increasing order of the source vertex, so the graph can be walked against the
+     * direction of its edges without building the reversed graph.
+     * The dense and bit matrices are read down column v in place. A sparse graph builds an
+     * index of its incoming edges the first time they are asked for, O(V+E) once per graph
+     * (and once more after it is modified).
+     */
+    NeighborRange Graph::inNeighbors(size_t v) const {
+        switch (layout) {
+            case StorageLayout::DENSE:
+                return denseMatrix.inNeighbors(v);
+            case StorageLayout::BITSET:
+                return bitMatrix.inNeighbors(v);
+            case StorageLayout::SUBGRAPH:
+                return subgraphEdges(v, true);
+            default:
+                return sparseInEdges().neighbors(v);
+        }
+    }
+
+    /**
+     * The incoming edges of a sparse graph in CSR form (the CSC form of the graph), built
+     * on the first call. Safe to call from several threads at once.
+     */
+    const CsrAdjacency& Graph::sparseInEdges() const {
+        InEdgeIndex& index = *inEdgeIndex;
+        std::call_once(index.built, [this, &index] {
+            switch (layout) {
+                case StorageLayout::DYNAMIC:
+                    index.edges = adjacencyLists.transposed();
+                    break;
+                case StorageLayout::COMPRESSED:
+                    index.edges = compressedAdjacency.transposed();
+                    break;
+                case StorageLayout::SUBGRAPH: {
+                    std::vector<std::pair<size_t, size_t>> edges;
+                    std::vector<Weight> weights;
+                    edges.reserve(numEdges);
+                    weights.reserve(numEdges);
+                    for (size_t u = 0; u < numVertices; ++u) {
+                        for (Neighbor edge : neighbors(u)) {
+                            edges.emplace_back(edge.vertex, u);
+                            weights.push_back(edge.weight);
+                        }
+                    }
+                    index.edges.buildFromEdges(numVertices, edges, weights);
+                    break;
                 }
+                default:
+                    index.edges = adjacency.transposed();
             }
+        });
+        return index.edges;
+    }
+
+    /**
+     * Returns the row of u in the bit matrix: bit v%64 of word v/64 is set iff u->v is an edge.
+     * Only valid when the storage layout is BITSET.
+     */
+    const uint64_t* Graph::adjacencyBits(size_t u) const {
+        return bitMatrix.row(u);
+    }
+
+    /**
+     * The number of 64 bit words in every row of the bit matrix.
+     */
+    size_t Graph::adjacencyWords() const {
+        return bitMatrix.rowWords();
+    }
+
+    /**
+     * Builds a copy of the graph with every edge reversed. To only walk the edges backwards,
+     * use inNeighbors instead, which doesn't copy the graph.
+     * @return The reversed graph, in the same storage layout.
+     */
+    Graph Graph::getReversedGraph() const {
+        // Create a new graph
+        Graph reversedGraph;
+
+        // Reverse the edges in the same layout, without going through a nested matrix
+        reversedGraph.numVertices = numVertices;
+        reversedGraph.layout = layout;
+        switch (layout) {
+            case StorageLayout::DENSE:
+                reversedGraph.denseMatrix = denseMatrix.transposed();
+                break;
+            case StorageLayout::BITSET:
+                reversedGraph.bitMatrix = bitMatrix.transposed();
+                break;
+            default:
+                // the reversed edges of modified sparse graph come back in CSR form
+                reversedGraph.layout = StorageLayout::SPARSE;
+                reversedGraph.adjacency = sparseInEdges();
+                if (layout == StorageLayout::COMPRESSED)
+                    reversedGraph.compress();
         }
 
-        // Load the reversed adjacency matrix into the reversed graph
-        reversedGraph.loadGraph(reversedAdjacencyMatrix);
+        // reversing the edges keeps their number and weights, and maps a symmetric graph to itself,
+        // so both graphs share their properties, whether or not they are computed yet
+        reversedGraph.numEdges = numEdges;
+        reversedGraph.properties = properties;
+        // and the vertices keep their numbers
+        reversedGraph.originalIds = originalIds;
+        reversedGraph.internalIds = internalIds;
 
         return reversedGraph;
     }
@@ -138,31 +1259,56 @@ namespace ariel {
         // Create a new graph
         Graph modifiedGraph;
 
-        // Increase the size of the adjacency matrix to accommodate the new vertex
         size_t newSize = numVertices + 1;
-        std::vector<std::vector<int>> modifiedAdjacencyMatrix(newSize, std::vector<int>(newSize, 0));
+        // assign max value possible for each new outgoing edge
+        Weight outgoingEdgeWeight = 10000;
 
-        // Copy existing adjacency matrix to modified adjacency matrix
-        for (size_t i = 0; i < numVertices; ++i) {
-            for (size_t j = 0; j < numVertices; ++j) {
-                modifiedAdjacencyMatrix[i][j] = adjacencyMatrix[i][j];
+        // the vertices keep their numbers, and the new one is numbered last in both orders
+        if (isReordered()) {
+            modifiedGraph.originalIds = originalIds;
+            modifiedGraph.internalIds = internalIds;
+            modifiedGraph.originalIds.push_back(numVertices);
+            modifiedGraph.internalIds.push_back(numVertices);
+        }
+
+        if (layout == StorageLayout::DENSE) {
+            // Copy the existing matrix into a bigger one and fill the last row
+            modifiedGraph.denseMatrix = denseMatrix.resized(newSize);
+            for (size_t i = 0; i < numVertices; ++i) {
+                modifiedGraph.denseMatrix.setWeight(newSize - 1, i, outgoingEdgeWeight);
             }
+            modifiedGraph.numVertices = newSize;
+            modifiedGraph.numEdges = numEdges + numVertices;
+            modifiedGraph.layout = StorageLayout::DENSE;
+            return modifiedGraph;
         }
 
-        // assign max value possible for each new outgoing edge
-        int outgoingEdgeWeight = 10000;
+        // Copy the existing rows into CSR form, the new vertex has no incoming edges.
+        // A bit matrix can't hold the new weights, so it is converted as well.
+        std::vector<size_t> offsets(1, 0);
+        std::vector<size_t> targets;
+        std::vector<Weight> weights;
+        targets.reserve(numEdges + numVertices);
+        weights.reserve(numEdges + numVertices);
+        for (size_t u = 0; u < numVertices; ++u) {
+            for (Neighbor edge : neighbors(u)) {
+                targets.push_back(edge.vertex);
+                weights.push_back(edge.weight);
+            }
+            offsets.push_back(targets.size());
+        }
 
         // For directed graphs, add outgoing edges from the new vertex to each existing vertex
         for (size_t i = 0; i < numVertices; ++i) {
-            modifiedAdjacencyMatrix[newSize - 1][i] = outgoingEdgeWeight;
+            targets.push_back(i);
+            weights.push_back(outgoingEdgeWeight);
         }
+        offsets.push_back(targets.size());
 
-
-        // Set the weight of the self-loop of the new vertex to 0
-        modifiedAdjacencyMatrix[newSize - 1][newSize - 1] = 0;
-
-        // Load the modified adjacency matrix into the modified graph
-        modifiedGraph.loadGraph(modifiedAdjacencyMatrix);
+        // Load the modified adjacency into the modified graph
+        modifiedGraph.numVertices = newSize;
+        modifiedGraph.numEdges = targets.size();
+        modifiedGraph.adjacency = CsrAdjacency(std::move(offsets), std::move(targets), std::move(weights));
 
         return modifiedGraph;
     }
@@ -5,43 +5,153 @@
 
 #include <vector>
 #include "GraphProperties.hpp"
+#include "CsrAdjacency.hpp"
+#include "DenseMatrix.hpp"
+#include "BitMatrix.hpp"
+#include "AdjacencyLists.hpp"
+#include "CompressedAdjacency.hpp"
+#include "MatrixScanner.hpp"
+#include "Neighbors.hpp"
+#include "SubgraphFilter.hpp"
 #include <cstddef>
 #include <limits>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <string>
+#include <utility>
 
 /**
- * A class to represent a graph with adjacency matrix
+ * A class to represent a graph, stored in compressed sparse row form, as a flat dense matrix,
+ * or for unweighted graphs as a bit matrix, whichever takes less memory.
+ * A sparse graph moves to per-vertex edge vectors the first time it is modified.
+ * Very large sparse graphs can be kept as varint encoded rows instead, see compress.
+ * A graph can also be a view of a subgraph of another graph, see loadSubgraphView.
+ * The graph properties that loading doesn't already give are computed the first time they are
+ * asked for, and kept until the graph is modified.
  */
 
 namespace ariel {
     class Graph {
     private:
-        std::vector<std::vector<int>> adjacencyMatrix;
+        StorageLayout layout;
+        CsrAdjacency adjacency;
+        DenseMatrix denseMatrix;
+        BitMatrix bitMatrix;
+        AdjacencyLists adjacencyLists;
+        CompressedAdjacency compressedAdjacency;
+        // the graph a subgraph view reads, and the vertices and edges it keeps of it
+        const Graph* subgraphBase;
+        std::shared_ptr<const SubgraphFilter> subgraphFilter;
         size_t numVertices;
         size_t numEdges;
-        GraphType graphType;
-        EdgeType edgeType;
-        EdgeNegativity edgeNegativity;
+
+        // the graph properties, each computed from the edges on first use unless loading gave it,
+        // and shared by copies of the graph until one of them is modified
+        struct PropertyCache {
+            std::once_flag weightsClassified;
+            EdgeType edgeType;
+            EdgeNegativity edgeNegativity;
+            std::once_flag directionClassified;
+            GraphType graphType;
+        };
+        std::shared_ptr<PropertyCache> properties;
+
+        // the degree statistics, counted on first use and shared the same way
+        struct StatisticsCache {
+            std::once_flag counted;
+            DegreeStatistics statistics;
+        };
+        std::shared_ptr<StatisticsCache> degreeStatistics;
+
+        // the counts behind the graph properties, taken on the first modification and kept up to date
+        bool propertyCountsValid;
+        size_t nonUnitEdges;
+        size_t negativeEdges;
+        size_t unmatchedEdges;
+
+        // the original number of every vertex and the other way around, empty until the graph is reordered
+        std::vector<size_t> originalIds;
+        std::vector<size_t> internalIds;
+
+        // the incoming edges of a sparse graph, built on first use and shared by copies of the graph
+        struct InEdgeIndex {
+            std::once_flag built;
+            CsrAdjacency edges;
+        };
+        std::shared_ptr<InEdgeIndex> inEdgeIndex;
 
         void clearGraph() ;
-        [[nodiscard]] static bool isValidGraph(const std::vector<std::vector<int>>& adjacencyMatrix) ;
-        [[nodiscard]] static bool isSymmetricMatrix(const std::vector<std::vector<int>>& matrix) ;
+        void setProperties(GraphType graphType, EdgeType edgeType, EdgeNegativity edgeNegativity);
+        void classifyWeights(PropertyCache& cache) const;
+        void countDegrees(DegreeStatistics& statistics) const;
+        void storeMatrix(const std::vector<std::vector<Weight>>& matrix, StorageLayout storageLayout);
+        void applySummary(const MatrixSummary& summary);
+        void countProperties();
+        void applyPropertyCounts();
+        void updateEdge(size_t u, size_t v, Weight weight);
+        void convertLayout(StorageLayout storageLayout);
+        void checkVertices(size_t u, size_t v) const;
+        void loadEdgeList(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges,
+                          const std::vector<Weight>& weights);
+        [[nodiscard]] static bool isValidGraph(const std::vector<std::vector<Weight>>& adjacencyMatrix) ;
+        [[nodiscard]] bool isSymmetric() const;
+        [[nodiscard]] static StorageLayout chooseLayout(size_t numVertices, size_t numEdges, bool unweighted);
+        [[nodiscard]] const CsrAdjacency& sparseInEdges() const;
+        [[nodiscard]] NeighborRange subgraphEdges(size_t u, bool incoming) const;
+        void dropSubgraph();
 
     public:
         Graph();
 
         // graph methods
-        void loadGraph(const std::vector<std::vector<int>>& matrix);
+        void loadGraph(const std::vector<std::vector<Weight>>& matrix);
+        void loadGraph(const std::vector<std::vector<Weight>>& matrix, StorageLayout storageLayout);
+        void loadGraph(std::vector<std::vector<Weight>>&& matrix);
+        void loadGraphView(const std::vector<std::vector<Weight>>& matrix);
+        void loadGraphView(const Weight* cells, size_t numVertices, size_t rowStride);
+        void loadEdges(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges);
+        void loadEdges(size_t numVertices, const std::vector<std::pair<size_t, size_t>>& edges,
+                       const std::vector<Weight>& weights);
+        void loadAdjacency(CsrAdjacency built);
+        void loadSubgraphView(const Graph& parent, const std::vector<bool>& vertices);
+        void loadSubgraphView(const Graph& parent, const std::vector<bool>& vertices,
+                              const SubgraphFilter::EdgePredicate& keepEdge);
+        void save(const std::string& path) const;
+        void openMapped(const std::string& path);
+        void addEdge(size_t u, size_t v);
+        void addEdge(size_t u, size_t v, Weight weight);
+        void removeEdge(size_t u, size_t v);
+        void setWeight(size_t u, size_t v, Weight weight);
+        size_t addVertex();
+        void reorder(VertexOrder order);
+        void compress();
+        void makeEditable();
         void printGraph() const;
         bool isEmpty() const;
 
         // getters
         [[nodiscard]] size_t V() const;
+        [[nodiscard]] size_t E() const;
         [[nodiscard]] GraphType getGraphType() const;
         [[nodiscard]] EdgeType getEdgeType() const;
         [[nodiscard]] EdgeNegativity getEdgeNegativity() const;
-        [[nodiscard]] int getEdgeWeight(size_t u, size_t v) const;
+        [[nodiscard]] DegreeStatistics getDegreeStatistics() const;
+        [[nodiscard]] StorageLayout getStorageLayout() const;
+        [[nodiscard]] bool isView() const;
+        [[nodiscard]] bool isMapped() const;
+        [[nodiscard]] bool isReordered() const;
+        [[nodiscard]] size_t originalId(size_t v) const;
+        [[nodiscard]] size_t internalId(size_t v) const;
+        [[nodiscard]] size_t parentId(size_t v) const;
+        [[nodiscard]] Weight getEdgeWeight(size_t u, size_t v) const;
+        [[nodiscard]] size_t outDegree(size_t u) const;
+        [[nodiscard]] NeighborRange neighbors(size_t u) const;
+        [[nodiscard]] size_t inDegree(size_t v) const;
+        [[nodiscard]] NeighborRange inNeighbors(size_t v) const;
+        [[nodiscard]] const uint64_t* adjacencyBits(size_t u) const;
+        [[nodiscard]] size_t adjacencyWords() const;
         [[nodiscard]] Graph getReversedGraph() const;
         [[nodiscard]] Graph addVertexWithEdges() const;
     };
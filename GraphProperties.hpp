@@ -3,10 +3,45 @@
 #ifndef GRAPHPROPERTIES_HPP
 #define GRAPHPROPERTIES_HPP
 
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The type of the edge weights and the type of path lengths, picked when the library is built.
+ * Weights default to int; build with -DARIEL_WEIGHT_TYPE=int16_t for compact storage on memory
+ * bound workloads, or with float or double. Path lengths default to 64 bits so sums of many
+ * weights don't overflow, -DARIEL_DISTANCE_TYPE=double gives floating point distances.
+ */
+#ifndef ARIEL_WEIGHT_TYPE
+#define ARIEL_WEIGHT_TYPE int
+#endif
+#ifndef ARIEL_DISTANCE_TYPE
+#define ARIEL_DISTANCE_TYPE int64_t
+#endif
+
 namespace ariel {
 
+    typedef ARIEL_WEIGHT_TYPE Weight;
+    typedef ARIEL_DISTANCE_TYPE Distance;
+
     enum class GraphType { DIRECTED, UNDIRECTED };
     enum class EdgeType { WEIGHTED, UNWEIGHTED };
     enum class EdgeNegativity { NONE, NEGATIVE };
+    enum class StorageLayout { SPARSE, DENSE, BITSET, DYNAMIC, COMPRESSED, SUBGRAPH };
+    enum class VertexOrder { ORIGINAL, DEGREE, BFS, REVERSE_CUTHILL_MCKEE };
+
+    /**
+     * Degree statistics of a graph, see Graph::getDegreeStatistics.
+     * A self loop counts once towards the out degree and once towards the in degree of its vertex.
+     */
+    struct DegreeStatistics {
+        size_t maxOutDegree;
+        size_t maxInDegree;
+        // the number of edges per vertex, E / V
+        double averageDegree;
+        // the share of the cells of the adjacency matrix that hold an edge, E / V^2
+        double density;
+        size_t selfLoops;
+    };
 }
-#endif //GRAPHPROPERTIES_HPP
\ No newline at end of file
+#endif //GRAPHPROPERTIES_HPP
@@ -0,0 +1,225 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "GraphReader.hpp"
+#include "MappedFile.hpp"
+#include "TextParsing.hpp"
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ariel {
+
+    namespace {
+        // below this many bytes per thread, starting a thread costs more than it saves
+        const size_t MIN_CHUNK_BYTES = size_t(1) << 20;
+        const size_t NO_VERTEX_LIMIT = std::numeric_limits<size_t>::max();
+
+        struct LineFormat {
+            // the field in front of every edge line ('a' in DIMACS), 0 if edge lines start with a vertex
+            char arcPrefix;
+            // the number of the first vertex in the file
+            size_t indexBase;
+            // the number of vertices given by the header of the file, NO_VERTEX_LIMIT if it has none
+            size_t numVertices;
+            // whether every edge u v also stands for the edge v u
+            bool mirror;
+        };
+
+        struct ParsedEdges {
+            std::vector<std::pair<size_t, size_t>> edges;
+            std::vector<Weight> weights;
+            // one more than the largest vertex seen
+            size_t numVertices = 0;
+            std::exception_ptr error;
+        };
+
+        /**
+         * Parses the edge lines of [begin, end), which starts at the start of a line.
+         */
+        void parseChunk(const char* begin, const char* end, const LineFormat& format, ParsedEdges& parsed) {
+            for (const char* line = begin; line < end; line = text::nextLine(line, end)) {
+                size_t u = 0;
+                size_t v = 0;
+                Weight weight = 1;
+                if (!text::parseEdgeLine(line, end, format.arcPrefix, u, v, weight))
+                    continue;
+                if (u < format.indexBase || v < format.indexBase
+                    || u - format.indexBase >= format.numVertices || v - format.indexBase >= format.numVertices) {
+                    throw std::invalid_argument("Invalid graph file: edge endpoint out of range.");
+                }
+
+                u -= format.indexBase;
+                v -= format.indexBase;
+                if (u > text::MAX_VERTEX_INDEX || v > text::MAX_VERTEX_INDEX)
+                    throw text::lineError(line, end);
+                parsed.edges.emplace_back(u, v);
+                parsed.weights.push_back(weight);
+                if (format.mirror && u != v) {
+                    parsed.edges.emplace_back(v, u);
+                    parsed.weights.push_back(weight);
+                }
+                parsed.numVertices = std::max(parsed.numVertices, std::max(u, v) + 1);
+            }
+        }
+
+        /**
+         * Parses the edge lines of [begin, end) on as many threads as the machine has cores,
+         * with at least MIN_CHUNK_BYTES for every thread. The edges come back in file order.
+         * @throws std::invalid_argument for the first line (in file order) that can't be read.
+         */
+        ParsedEdges parseEdges(const char* begin, const char* end, const LineFormat& format) {
+            size_t bytes = static_cast<size_t>(end - begin);
+            size_t numThreads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(),
+                                                                       bytes / MIN_CHUNK_BYTES));
+
+            // every chunk but the first starts on the line after its even share of the bytes
+            std::vector<const char*> bounds(numThreads + 1, end);
+            bounds[0] = begin;
+            for (size_t i = 1; i < numThreads; ++i)
+                bounds[i] = std::max(bounds[i - 1], text::nextLine(begin + bytes / numThreads * i, end));
+
+            std::vector<ParsedEdges> chunks(numThreads);
+            auto parse = [&](size_t i) {
+                try {
+                    parseChunk(bounds[i], bounds[i + 1], format, chunks[i]);
+                } catch (...) {
+                    chunks[i].error = std::current_exception();
+                }
+            };
+            std::vector<std::thread> workers;
+            for (size_t i = 1; i < numThreads; ++i)
+                workers.emplace_back(parse, i);
+            parse(0);
+            for (std::thread& worker : workers)
+                worker.join();
+
+            size_t numEdges = 0;
+            for (const ParsedEdges& chunk : chunks)
+                numEdges += chunk.edges.size();
+            ParsedEdges parsed = std::move(chunks[0]);
+            parsed.edges.reserve(numEdges);
+            parsed.weights.reserve(numEdges);
+            for (size_t i = 1; i < numThreads; ++i) {
+                parsed.edges.insert(parsed.edges.end(), chunks[i].edges.begin(), chunks[i].edges.end());
+                parsed.weights.insert(parsed.weights.end(), chunks[i].weights.begin(), chunks[i].weights.end());
+                parsed.numVertices = std::max(parsed.numVertices, chunks[i].numVertices);
+                if (parsed.error == nullptr)
+                    parsed.error = chunks[i].error;
+                // free every chunk once it is copied
+                chunks[i] = ParsedEdges();
+            }
+            if (parsed.error != nullptr)
+                std::rethrow_exception(parsed.error);
+            return parsed;
+        }
+
+        std::string readWord(const char*& p, const char* end) {
+            text::skipSpaces(p, end);
+            std::string word;
+            for (; !text::atFieldEnd(p, end); ++p)
+                word += static_cast<char>(std::tolower(static_cast<unsigned char>(*p)));
+            return word;
+        }
+
+        const char* fileStart(const MappedFile& file) {
+            return reinterpret_cast<const char*>(file.data());
+        }
+    }
+
+    /**
+     * Loads an edge list file into g.
+     * @throws std::runtime_error if the file can't be opened.
+     * @throws std::invalid_argument if a line can't be read, or an edge appears twice.
+     */
+    void GraphReader::readEdgeList(Graph& g, const std::string& path) {
+        MappedFile file(path);
+        const char* begin = fileStart(file);
+        ParsedEdges parsed = parseEdges(begin, begin + file.size(), LineFormat{0, 0, NO_VERTEX_LIMIT, false});
+        g.loadEdges(parsed.numVertices, parsed.edges, parsed.weights);
+    }
+
+    /**
+     * Loads a DIMACS shortest path file into g.
+     * @throws std::runtime_error if the file can't be opened.
+     * @throws std::invalid_argument if the file has no problem line before its first arc,
+     *         a line can't be read, a vertex is out of range, or an edge appears twice.
+     */
+    void GraphReader::readDimacs(Graph& g, const std::string& path) {
+        MappedFile file(path);
+        const char* begin = fileStart(file);
+        const char* end = begin + file.size();
+
+        // the problem line comes before the arcs, the arcs are parsed from the first one on
+        size_t numVertices = NO_VERTEX_LIMIT;
+        const char* line = begin;
+        for (; line < end; line = text::nextLine(line, end)) {
+            const char* p = line;
+            text::skipSpaces(p, end);
+            if (p < end && *p == 'a')
+                break;
+            if (p < end && *p == 'p') {
+                ++p;
+                size_t numArcs = 0;
+                if (readWord(p, end).empty() || !text::parseIndex(p, end, numVertices) || !text::parseIndex(p, end, numArcs))
+                    throw text::lineError(line, end);
+            }
+        }
+        if (numVertices == NO_VERTEX_LIMIT) {
+            throw std::invalid_argument("Invalid graph file: " + path + " has no problem line.");
+        }
+
+        ParsedEdges parsed = parseEdges(line, end, LineFormat{'a', 1, numVertices, false});
+        g.loadEdges(numVertices, parsed.edges, parsed.weights);
+    }
+
+    /**
+     * Loads a Matrix Market coordinate file into g, the entry (i,j) being the edge i->j.
+     * @throws std::runtime_error if the file can't be opened.
+     * @throws std::invalid_argument if the file is not a square coordinate matrix of a supported
+     *         kind, a line can't be read, an entry is out of range, or an entry appears twice.
+     */
+    void GraphReader::readMatrixMarket(Graph& g, const std::string& path) {
+        MappedFile file(path);
+        const char* begin = fileStart(file);
+        const char* end = begin + file.size();
+
+        const char* p = begin;
+        std::string banner = readWord(p, end);
+        std::string object = readWord(p, end);
+        std::string layout = readWord(p, end);
+        std::string field = readWord(p, end);
+        std::string symmetry = readWord(p, end);
+        if (banner != "%%matrixmarket" || object != "matrix" || layout != "coordinate"
+            || (field != "real" && field != "integer" && field != "pattern")
+            || (symmetry != "general" && symmetry != "symmetric")) {
+            throw std::invalid_argument("Invalid graph file: " + path + " is not a real, integer or pattern "
+                                        "coordinate matrix, general or symmetric.");
+        }
+
+        // the size line is the first line after the banner that isn't blank or a comment
+        const char* line = text::nextLine(begin, end);
+        for (; line < end; line = text::nextLine(line, end)) {
+            p = line;
+            text::skipSpaces(p, end);
+            if (!text::atLineEnd(p, end) && *p != '%')
+                break;
+        }
+        size_t rows = 0;
+        size_t columns = 0;
+        size_t entries = 0;
+        p = line;
+        if (!text::parseIndex(p, end, rows) || !text::parseIndex(p, end, columns) || !text::parseIndex(p, end, entries))
+            throw text::lineError(line, end);
+        if (rows != columns) {
+            throw std::invalid_argument("Invalid graph file: " + path + " is not a square matrix.");
+        }
+
+        ParsedEdges parsed = parseEdges(text::nextLine(line, end), end, LineFormat{0, 1, rows, symmetry == "symmetric"});
+        g.loadEdges(rows, parsed.edges, parsed.weights);
+    }
+}
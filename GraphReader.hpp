@@ -0,0 +1,33 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef GRAPH_READER_HPP
+#define GRAPH_READER_HPP
+
+#include "Graph.hpp"
+#include <string>
+
+/**
+ * Loads a graph straight from a text file, without going through an adjacency matrix.
+ * The file is mapped into memory and cut into chunks at line boundaries, which are parsed
+ * on several threads at once; the edges then go to Graph::loadEdges.
+ * Supported formats:
+ *  - an edge list: one "u v [weight]" line per edge, vertices numbered from 0, lines
+ *    starting with # or % are comments. The graph has as many vertices as the largest
+ *    vertex number plus one.
+ *  - DIMACS shortest path (.gr): a "p sp n m" line, then "a u v weight" lines, vertices
+ *    numbered from 1, lines starting with c are comments.
+ *  - Matrix Market coordinate files of a square matrix, real, integer or pattern, general or
+ *    symmetric (every off diagonal entry of a symmetric matrix stands for both edges).
+ * A missing weight is 1. An integral weight type only accepts whole numbers, such as 3 or 3.0e0.
+ */
+
+namespace ariel {
+    class GraphReader {
+    public:
+        static void readEdgeList(Graph& g, const std::string& path);
+        static void readDimacs(Graph& g, const std::string& path);
+        static void readMatrixMarket(Graph& g, const std::string& path);
+    };
+}
+
+#endif // GRAPH_READER_HPP
@@ -0,0 +1,130 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef HEAP_SEARCH_HPP
+#define HEAP_SEARCH_HPP
+
+#include "Graph.hpp"
+#include "QueryWorkspace.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * The heap loop shared by the searches that settle vertices in the order of a key: Dijkstra's
+ * algorithm (keyed by distance), A* (distance plus a bound on the rest of the way), both halves of
+ * bidirectional Dijkstra and the landmark distances.
+ */
+
+namespace ariel {
+
+    // the edges a search follows: out of every vertex, or into it to search back from a destination
+    enum class EdgeDirection { OUTGOING, INCOMING };
+
+    // the key of Dijkstra's algorithm, the distance itself
+    struct DistanceKey {
+        Distance operator()(size_t, Distance distance) const {
+            return distance;
+        }
+    };
+
+    /**
+     * A search over the distances, parents and heap of a workspace, which the caller resets first.
+     * Key maps a vertex and its distance to the key of its heap entries, and must give the same key
+     * for the same distance every time it is asked.
+     * Entries of a vertex that was pushed again with a shorter distance since are stale, and are
+     * skipped. Of the predecessors that give a vertex its distance, it keeps the lowest numbered one,
+     * so the path doesn't depend on the order of the heap.
+     */
+    template <typename Key = DistanceKey>
+    class HeapSearch {
+    public:
+        HeapSearch(const Graph& g, QueryWorkspace& workspace, EdgeDirection direction, const Key& key = Key())
+                : g(g), workspace(workspace), direction(direction), keyOf(key), heap(workspace.heap()),
+                  numSettled(0) {}
+
+        void start(size_t source) {
+            workspace.setDistance(source, 0);
+            push(source, 0);
+        }
+
+        [[nodiscard]] bool empty() const {
+            return heap.empty();
+        }
+
+        // the smallest key in the heap, which must not be empty
+        [[nodiscard]] Distance topKey() const {
+            return heap.front().first;
+        }
+
+        // the number of vertices settled so far
+        [[nodiscard]] size_t settled() const {
+            return numSettled;
+        }
+
+        // pops the heap up to the next vertex that is not stale, and returns it, or NO_VERTEX once it is empty
+        size_t settleNext() {
+            while (!heap.empty()) {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                Distance key = heap.back().first;
+                size_t u = heap.back().second;
+                heap.pop_back();
+                if (key > keyOf(u, workspace.distance(u)))
+                    continue;
+                ++numSettled;
+                return u;
+            }
+            return QueryWorkspace::NO_VERTEX;
+        }
+
+        // relaxes the edges of u in the direction of the search, and passes the vertex at the other end
+        // of every edge to onEdge once the edge is relaxed
+        template <typename OnEdge>
+        void relax(size_t u, OnEdge onEdge) {
+            Distance dist_u = workspace.distance(u);
+            for (Neighbor edge : direction == EdgeDirection::OUTGOING ? g.neighbors(u) : g.inNeighbors(u)) {
+                size_t v = edge.vertex;
+                Distance dist_v = dist_u + edge.weight;
+                if (workspace.distance(v) > dist_v) {
+                    workspace.setDistance(v, dist_v);
+                    workspace.setParent(v, u);
+                    push(v, dist_v);
+                } else if (workspace.distance(v) == dist_v && edge.weight != 0 && u < workspace.parent(v)) {
+                    workspace.setParent(v, u);
+                }
+                onEdge(v);
+            }
+        }
+
+        void relax(size_t u) {
+            relax(u, [](size_t) {});
+        }
+
+        // searches from source until dest is settled, or over everything source reaches if dest is NO_VERTEX
+        // returns the number of vertices settled
+        size_t run(size_t source, size_t dest) {
+            start(source);
+            for (size_t u = settleNext(); u != QueryWorkspace::NO_VERTEX && u != dest; u = settleNext())
+                relax(u);
+            return numSettled;
+        }
+
+    private:
+        const Graph& g;
+        QueryWorkspace& workspace;
+        EdgeDirection direction;
+        Key keyOf;
+        // a binary min heap of (key, vertex) pairs
+        std::vector<std::pair<Distance, size_t>>& heap;
+        std::greater<std::pair<Distance, size_t>> later;
+        size_t numSettled;
+
+        void push(size_t v, Distance distance) {
+            heap.emplace_back(keyOf(v, distance), v);
+            std::push_heap(heap.begin(), heap.end(), later);
+        }
+    };
+}
+
+#endif // HEAP_SEARCH_HPP
@@ -9,54 +9,90 @@ namespace ariel {
      * @return A string describing the bipartite partitioning of the graph, or an error message if the graph is not bipartite.
      */
     std::string IsBipartite::Execute(const ariel::Graph &g) {
+        QueryWorkspace workspace;
+        return Execute(g, workspace);
+    }
+
+    /**
+     * Determines whether the graph is bipartite or not, keeping the colors in workspace.
+     * @param workspace Reused by every query of the calling thread, so the coloring doesn't allocate memory.
+     */
+    std::string IsBipartite::Execute(const ariel::Graph &g, QueryWorkspace& workspace) {
+        return toMessage(Find(g, workspace));
+    }
+
+    /**
+     * Determines whether the graph is bipartite or not.
+     * @param g The graph to check for bipartite.
+     * @return The side of every vertex if the graph is bipartite, its status otherwise.
+     */
+    BipartiteResult IsBipartite::Find(const ariel::Graph &g) {
+        QueryWorkspace workspace;
+        return Find(g, workspace);
+    }
+
+    /**
+     * Determines whether the graph is bipartite or not, keeping the colors in workspace.
+     * The state of a vertex is its color plus one, 0 while it is uncolored.
+     * @param workspace Reused by every query of the calling thread, so only the result allocates memory.
+     */
+    BipartiteResult IsBipartite::Find(const ariel::Graph &g, QueryWorkspace& workspace) {
         // empty graph
         if(g.isEmpty())
-            return "Graph is empty";
+            return BipartiteResult{BipartiteStatus::EMPTY_GRAPH, std::vector<bool>()};
+
+        workspace.reset(g.V()); // every vertex starts uncolored
 
-        std::vector<int> colors(g.V(), -1); // Initialize all colors to -1
+        // Bit matrices are colored a word at a time, all components in one go
+        if (g.getStorageLayout() == StorageLayout::BITSET) {
+            if (!colorGraphBitParallel(g, workspace))
+                return BipartiteResult{BipartiteStatus::NOT_BIPARTITE, std::vector<bool>()};
+            return FindPartition(g, workspace);
+        }
 
-        // Start BFS traversal from an arbitrary vertex
-        for (size_t v = 0; v < g.V(); ++v) {
-            if (colors[v] == -1) {
-                if (!colorGraphBFS(g, colors, v)) {
-                    return "Graph is not bipartite";
+        // Start a BFS from every uncolored vertex, in the original order of the vertices, so the
+        // first vertex of every component gets color 0 whether or not the graph was reordered
+        for (size_t i = 0; i < g.V(); ++i) {
+            size_t v = g.internalId(i);
+            if (workspace.state(v) == 0) {
+                if (!colorGraphBFS(g, workspace, v)) {
+                    return BipartiteResult{BipartiteStatus::NOT_BIPARTITE, std::vector<bool>()};
                 }
             }
         }
 
-        return FindPartition(colors); // Graph is bipartite
+        return FindPartition(g, workspace); // Graph is bipartite
     }
 
     /**
      * Colors the graph vertices using Breadth-First Search (BFS) traversal to determine bipartiteness.
      * the idea was took from TA session in course "Algorithms 1"
      * @param g The graph to be colored.
-     * @param colors A vector to store the color of each vertex.
+     * @param workspace Keeps the color of each vertex, and the queue of the traversal.
      * @param start The starting vertex for BFS traversal.
      * @return True if the graph is bipartite, false otherwise.
      */
-    bool IsBipartite::colorGraphBFS(const Graph& g, std::vector<int>& colors, size_t start) {
-        std::queue<size_t> q;
-        q.push(start);
-        colors[start] = 0; // Color the starting vertex
+    bool IsBipartite::colorGraphBFS(const Graph& g, QueryWorkspace& workspace, size_t start) {
+        std::vector<size_t>& q = workspace.queue();
+        q.clear();
+        size_t head = 0;
+        q.push_back(start);
+        workspace.setState(start, 1); // Color the starting vertex
 
-        while (!q.empty()) {
-            size_t current = q.front();
-            q.pop();
+        while (head < q.size()) {
+            size_t current = q[head++];
 
             // Iterate over neighbors of the current vertex
-            for (size_t v = 0; v < g.V(); ++v) {
-                // Check if there is an edge between current and v
-                if (g.getEdgeWeight(current, v) != 0) {
-                    // Check if neighbor v is not colored yet
-                    if (colors[v] == -1) {
-                        // Color the neighbor with a different color than the current vertex
-                        colors[v] = 1 - colors[current];
-                        q.push(v);
-                    } else if (colors[v] == colors[current]) {
-                        // If neighbor has the same color as the current vertex, graph is not bipartite
-                        return false;
-                    }
+            for (Neighbor edge : g.neighbors(current)) {
+                size_t v = edge.vertex;
+                // Check if neighbor v is not colored yet
+                if (workspace.state(v) == 0) {
+                    // Color the neighbor with a different color than the current vertex
+                    workspace.setState(v, static_cast<uint8_t>(3 - workspace.state(current)));
+                    q.push_back(v);
+                } else if (workspace.state(v) == workspace.state(current)) {
+                    // If neighbor has the same color as the current vertex, graph is not bipartite
+                    return false;
                 }
             }
         }
@@ -67,36 +103,66 @@ namespace ariel {
 
 
     /**
-     * Finds the partitioning of the bipartite graph into two sets.
-     * @param colors A vector containing the color of each vertex.
-     * @return A string representing the bipartite partitioning of the graph.
+     * Colors every component of a graph stored as a bit matrix, with the same BFS order as colorGraphBFS.
+     * Two bitmaps track the colored vertices and the vertices of color 1, so for the current vertex
+     * row & ~colored are its new neighbors and row & colored & (its own color) are the conflicts.
+     * @param g The graph to be colored, its storage layout must be BITSET.
+     * @param workspace Keeps the color of each vertex, the two bitmaps and the queue of the traversal.
+     * @return True if the graph is bipartite, false otherwise.
      */
-    std::string IsBipartite::FindPartition(std::vector<int> &colors) {
-        // init A and B
-        std::vector<size_t> A, B;
-
-        // Populate sets A and B based on colors
-        for (size_t i = 0; i < colors.size(); ++i) {
-            if (colors[i] == 0) {
-                A.push_back(i);
-            } else {
-                B.push_back(i);
-            }
-        }
+    bool IsBipartite::colorGraphBitParallel(const Graph& g, QueryWorkspace& workspace) {
+        size_t words = g.adjacencyWords();
+        std::vector<uint64_t>& colored = workspace.bitmap(0, words);
+        std::vector<uint64_t>& colorOne = workspace.bitmap(1, words);
+        std::vector<size_t>& q = workspace.queue();
 
-        // Now return the result in the desired format
-        std::string result = "Graph is bipartite, A={";
-        for (size_t i = 0; i < A.size(); ++i) {
-            result += std::to_string(A[i]);
-            if (i != A.size() - 1) result += ",";
-        }
-        result += "}, B={";
-        for (size_t i = 0; i < B.size(); ++i) {
-            result += std::to_string(B[i]);
-            if (i != B.size() - 1) result += ",";
+        for (size_t i = 0; i < g.V(); ++i) {
+            size_t start = g.internalId(i);
+            if (workspace.state(start) != 0)
+                continue;
+            workspace.setState(start, 1); // Color the starting vertex
+            colored[start / 64] |= uint64_t(1) << (start % 64);
+            q.clear();
+            size_t head = 0;
+            q.push_back(start);
+
+            while (head < q.size()) {
+                size_t current = q[head++];
+                const uint64_t* row = g.adjacencyBits(current);
+                bool currentIsOne = workspace.state(current) == 2;
+
+                for (size_t w = 0; w < words; ++w) {
+                    uint64_t sameColor = currentIsOne ? colorOne[w] : ~colorOne[w];
+                    // a neighbor that already has the color of current breaks the bipartition
+                    if ((row[w] & colored[w] & sameColor) != 0)
+                        return false;
+
+                    uint64_t discovered = row[w] & ~colored[w];
+                    colored[w] |= discovered;
+                    if (!currentIsOne)
+                        colorOne[w] |= discovered;
+                    while (discovered != 0) {
+                        size_t v = w * 64 + static_cast<size_t>(__builtin_ctzll(discovered));
+                        workspace.setState(v, currentIsOne ? 1 : 2);
+                        q.push_back(v);
+                        discovered &= discovered - 1;
+                    }
+                }
+            }
         }
-        result += "}";
+        return true;
+    }
 
+    /**
+     * Finds the partitioning of the bipartite graph into two sets.
+     * @param g The colored graph, the sets list the original numbers of its vertices.
+     * @param workspace Keeps the color of each vertex.
+     * @return The side of every vertex, A for the vertices of color 0.
+     */
+    BipartiteResult IsBipartite::FindPartition(const Graph& g, const QueryWorkspace& workspace) {
+        BipartiteResult result{BipartiteStatus::BIPARTITE, std::vector<bool>(g.V())};
+        for (size_t i = 0; i < g.V(); ++i)
+            result.inA[i] = workspace.state(g.internalId(i)) == 1;
         return result;
     }
 }
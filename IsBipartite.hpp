@@ -3,8 +3,10 @@
 #ifndef IS_BIPARTITE_HPP
 #define IS_BIPARTITE_HPP
 
+#include "AlgorithmResults.hpp"
 #include "Graph.hpp"
 #include "IsConnected.hpp"
+#include "QueryWorkspace.hpp"
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -14,10 +16,14 @@ namespace ariel {
     class IsBipartite {
     public:
         static std::string Execute(const ariel::Graph &g);
+        static std::string Execute(const ariel::Graph &g, QueryWorkspace& workspace);
+        static BipartiteResult Find(const ariel::Graph &g);
+        static BipartiteResult Find(const ariel::Graph &g, QueryWorkspace& workspace);
 
     private:
-        static bool  colorGraphBFS(const Graph& g, std::vector<int>& colors, size_t start);
-        static std::string FindPartition(std::vector<int>& colors);
+        static bool  colorGraphBFS(const Graph& g, QueryWorkspace& workspace, size_t start);
+        static bool colorGraphBitParallel(const Graph& g, QueryWorkspace& workspace);
+        static BipartiteResult FindPartition(const Graph& g, const QueryWorkspace& workspace);
     };
 }
 
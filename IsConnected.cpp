@@ -12,19 +12,30 @@ namespace ariel {
      * @throws std::runtime_error if encountering an unknown graph type.
      */
     bool IsConnected::Execute(const ariel::Graph &g) {
+        QueryWorkspace workspace;
+        return Execute(g, workspace);
+    }
+
+    /**
+     * Determines whether the graph is connected or not, marking the visited vertices in workspace
+     * (with state 1).
+     * @param workspace Reused by every query of the calling thread, so the search doesn't allocate memory.
+     */
+    bool IsConnected::Execute(const ariel::Graph &g, QueryWorkspace& workspace) {
         // empty graph
         if(g.isEmpty())
             return "Graph is empty";
+        workspace.reset(g.V());
 
         // Switch based on the type of graph (directed or undirected)
         switch (g.getGraphType()) {
             // For directed graph, use specialized function to check connectivity
             case(GraphType::DIRECTED):
-                return isConnectedDirected(g);
+                return isConnectedDirected(g, workspace);
 
                 // For undirected graph, use specialized function to check connectivity
             case(GraphType::UNDIRECTED):
-                return isConnectedUndirected(g);
+                return isConnectedUndirected(g, workspace);
 
                 // Handle the case of encountering an unknown graph type
             default:
@@ -38,18 +49,12 @@ namespace ariel {
       * @param g The undirected graph to check for connectivity.
       * @return True if the undirected graph is connected, false otherwise.
       */
-    bool IsConnected::isConnectedUndirected(const ariel::Graph &g) {
-        // Initialize a vector to track visited vertices during DFS
-        std::vector<bool> visited(g.V(), false);
-
+    bool IsConnected::isConnectedUndirected(const ariel::Graph &g, QueryWorkspace& workspace) {
         // Start DFS from an arbitrary vertex (vertex 0)
-        dfs(g, visited, 0);
+        dfs(g, workspace, 0);
 
         // Check if all vertices were visited during DFS
-        for(size_t v = 0; v < g.V(); ++v)
-            if(!visited[v])
-                return false;
-        return true;
+        return allVisited(g, workspace);
     }
 
     /**
@@ -59,48 +64,121 @@ namespace ariel {
      * @return True if the directed graph is strongly connected, false otherwise.
      *  took the idea from : https://www.geeksforgeeks.org/check-if-a-directed-graph-is-connected-or-not/
      */
-    bool IsConnected::isConnectedDirected(const ariel::Graph &g) {
-        // Initialize visited arrays for DFS traversal and reverse DFS traversal
-        std::vector<bool> vis1(g.V(), false);
-        std::vector<bool> vis2(g.V(), false);
-
-        // Step 1: Run DFS from a random vertex and mark all visited vertices in vis1
-        dfs(g, vis1, 0);
-        // Check if all vertices are visited in vis1
-        for (bool visited : vis1) {
-            if (!visited)
-                return false; // Not strongly connected
-        }
-
-        // Step 2: Reverse the direction of all edges in the graph
-        ariel::Graph gReversed = g.getReversedGraph();
-
-        // Step 3: Run DFS from the same random vertex in the reversed graph and mark all visited vertices in vis2
-        dfs(gReversed, vis2, 0);
+    bool IsConnected::isConnectedDirected(const ariel::Graph &g, QueryWorkspace& workspace) {
+        // Step 1: Run DFS from a random vertex and check if all vertices are visited
+        dfs(g, workspace, 0);
+        if (!allVisited(g, workspace))
+            return false; // Not strongly connected
+
+        // Step 2: Unmark the vertices in O(1), and run DFS from the same vertex against the direction
+        // of the edges (a DFS in the reversed graph, without building it)
+        workspace.clearVertices();
+        reverseDfs(g, workspace, 0);
+
+        // Step 3: Check if any vertex is not visited
+        return allVisited(g, workspace);
+    }
 
-        // Step 4: Check if any vertex is not visited in vis2
-        for (bool visited : vis2) {
-            if (!visited)
-                return false; // Not strongly connected
-        }
+    /**
+     * @return True if every vertex of g was marked visited in workspace, false otherwise.
+     */
+    bool IsConnected::allVisited(const Graph &g, const QueryWorkspace& workspace) {
+        for (size_t v = 0; v < g.V(); ++v)
+            if (workspace.state(v) == 0)
+                return false;
         return true;
     }
 
 
     /**
      * Depth-First Search (DFS) traversal of the graph starting from a given vertex.
+     * Uses an explicit stack instead of recursion, so deep graphs can't overflow the call stack.
      * @param g The graph to perform DFS traversal on.
-     * @param visited A vector indicating whether each vertex has been visited.
+     * @param workspace Marks the visited vertices, and keeps the stack of the traversal.
      * @param start The starting vertex for DFS traversal.
      */
-    void IsConnected::dfs(const Graph &g, std::vector<bool>& visited, size_t start) {
-        // Mark the current vertex as visited
-        visited[start] = true;
-
-        // Iterate over all adjacent vertices and recursively visit unvisited vertices
-        for(size_t v = 0; v < g.V(); ++v){
-            if(g.getEdgeWeight(start, v) != 0 && !visited[v])
-                dfs(g, visited, v);
+    void IsConnected::dfs(const Graph &g, QueryWorkspace& workspace, size_t start) {
+        if (g.getStorageLayout() == StorageLayout::BITSET) {
+            searchBitParallel(g, workspace, start);
+            return;
+        }
+
+        std::vector<size_t>& stack = workspace.queue();
+        stack.clear();
+        // Mark the start vertex as visited
+        workspace.setState(start, 1);
+        stack.push_back(start);
+
+        while (!stack.empty()) {
+            size_t u = stack.back();
+            stack.pop_back();
+
+            // Iterate over all adjacent vertices and push the unvisited ones
+            for (Neighbor edge : g.neighbors(u)) {
+                if (workspace.state(edge.vertex) == 0) {
+                    workspace.setState(edge.vertex, 1);
+                    stack.push_back(edge.vertex);
+                }
+            }
+        }
+    }
+
+    /**
+     * Marks every vertex that can reach start, by a DFS that follows the incoming edges of each vertex.
+     * @param g The graph to perform the traversal on.
+     * @param workspace Marks the visited vertices, and keeps the stack of the traversal.
+     * @param start The starting vertex for the traversal.
+     */
+    void IsConnected::reverseDfs(const Graph &g, QueryWorkspace& workspace, size_t start) {
+        std::vector<size_t>& stack = workspace.queue();
+        stack.clear();
+        workspace.setState(start, 1);
+        stack.push_back(start);
+
+        while (!stack.empty()) {
+            size_t v = stack.back();
+            stack.pop_back();
+
+            for (Neighbor edge : g.inNeighbors(v)) {
+                if (workspace.state(edge.vertex) == 0) {
+                    workspace.setState(edge.vertex, 1);
+                    stack.push_back(edge.vertex);
+                }
+            }
+        }
+    }
+
+    /**
+     * Marks every vertex reachable from start in a graph stored as a bit matrix.
+     * The unvisited neighbors of a vertex are found 64 at a time with row & ~visited.
+     * @param g The graph to search, its storage layout must be BITSET.
+     * @param workspace Marks the visited vertices, and keeps the bitmap and the stack of the search.
+     * @param start The starting vertex for the search.
+     */
+    void IsConnected::searchBitParallel(const Graph &g, QueryWorkspace& workspace, size_t start) {
+        size_t words = g.adjacencyWords();
+        std::vector<uint64_t>& reached = workspace.bitmap(0, words);
+        std::vector<size_t>& stack = workspace.queue();
+        stack.clear();
+
+        reached[start / 64] |= uint64_t(1) << (start % 64);
+        workspace.setState(start, 1);
+        stack.push_back(start);
+
+        while (!stack.empty()) {
+            const uint64_t* row = g.adjacencyBits(stack.back());
+            stack.pop_back();
+
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t discovered = row[w] & ~reached[w];
+                reached[w] |= discovered;
+                while (discovered != 0) {
+                    size_t v = w * 64 + static_cast<size_t>(__builtin_ctzll(discovered));
+                    workspace.setState(v, 1);
+                    stack.push_back(v);
+                    discovered &= discovered - 1;
+                }
+            }
         }
     }
 }
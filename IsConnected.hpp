@@ -5,16 +5,21 @@
 
 #include "DetectCycle.hpp"
 #include "Graph.hpp"
+#include "QueryWorkspace.hpp"
 using namespace std;
 
 namespace ariel {
     class IsConnected {
     public:
             static bool Execute(const ariel::Graph &g);
+            static bool Execute(const ariel::Graph &g, QueryWorkspace& workspace);
     private:
-        static bool isConnectedDirected(const Graph& g);
-        static bool isConnectedUndirected(const Graph& g);
-        static void dfs(const Graph& g, std::vector<bool>& visited , size_t start);
+        static bool isConnectedDirected(const Graph& g, QueryWorkspace& workspace);
+        static bool isConnectedUndirected(const Graph& g, QueryWorkspace& workspace);
+        static bool allVisited(const Graph& g, const QueryWorkspace& workspace);
+        static void dfs(const Graph& g, QueryWorkspace& workspace, size_t start);
+        static void reverseDfs(const Graph& g, QueryWorkspace& workspace, size_t start);
+        static void searchBitParallel(const Graph& g, QueryWorkspace& workspace, size_t start);
 
     };
 }
@@ -0,0 +1,113 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "Landmarks.hpp"
+#include "HeapSearch.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace ariel {
+
+    /**
+     * Picks the landmarks of a graph and computes the distances from and to every one of them,
+     * with two runs of Dijkstra per landmark.
+     * @param g The graph, without negative weights.
+     * @param count The number of landmarks, at most the number of vertices.
+     * @throws std::invalid_argument if the graph is empty or has negative weights, or count is 0.
+     */
+    Landmarks::Landmarks(const Graph& g, size_t count) : n(g.V()) {
+        if (g.isEmpty() || count == 0)
+            throw std::invalid_argument("Landmarks need a graph and at least one landmark");
+        if (g.getEdgeNegativity() == EdgeNegativity::NEGATIVE)
+            throw std::invalid_argument("Landmarks need a graph without negative weights");
+        count = std::min(count, n);
+        const Distance infinity = std::numeric_limits<Distance>::max();
+        fromLandmark.assign(n * count, infinity);
+        toLandmark.assign(n * count, infinity);
+
+        QueryWorkspace workspace;
+        // the distance of every vertex from the nearest landmark picked so far
+        std::vector<Distance> nearest(n, infinity);
+        std::vector<bool> picked(n, false);
+        // the first landmark is the vertex farthest from vertex 0
+        size_t next = g.internalId(0);
+        distancesFrom(g, next, false, workspace);
+        for (size_t v = 0; v < n; ++v) {
+            if (workspace.distance(v) != infinity && workspace.distance(v) > workspace.distance(next))
+                next = v;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            landmarks.push_back(g.originalId(next));
+            picked[next] = true;
+            distancesFrom(g, next, false, workspace);
+            for (size_t v = 0; v < n; ++v) {
+                fromLandmark[g.originalId(v) * count + i] = workspace.distance(v);
+                nearest[v] = std::min(nearest[v], workspace.distance(v));
+            }
+            distancesFrom(g, next, true, workspace);
+            for (size_t v = 0; v < n; ++v)
+                toLandmark[g.originalId(v) * count + i] = workspace.distance(v);
+
+            // the next landmark is the vertex farthest from all of these, an unreached one if any is
+            // left, the first one in the original order on ties
+            next = QueryWorkspace::NO_VERTEX;
+            for (size_t j = 0; j < n; ++j) {
+                size_t v = g.internalId(j);
+                if (!picked[v] && (next == QueryWorkspace::NO_VERTEX || nearest[v] > nearest[next]))
+                    next = v;
+            }
+        }
+    }
+
+    size_t Landmarks::size() const {
+        return landmarks.size();
+    }
+
+    // the number of vertices of the graph the landmarks were picked on
+    size_t Landmarks::numVertices() const {
+        return n;
+    }
+
+    // the landmarks, in the order they were picked
+    const std::vector<size_t>& Landmarks::vertices() const {
+        return landmarks;
+    }
+
+    /**
+     * A lower bound on the distance from v to dest, by the triangle inequality over every landmark
+     * that reaches (or is reached from) both of them. Landmarks that don't give a bound are skipped,
+     * so the bound is 0 at worst, and never more than the distance.
+     * @throws std::invalid_argument if v or dest is not a vertex of the graph.
+     */
+    Distance Landmarks::lowerBound(size_t v, size_t dest) const {
+        if (v >= n || dest >= n)
+            throw std::invalid_argument("Vertex out of range of the landmarks");
+        const Distance infinity = std::numeric_limits<Distance>::max();
+        size_t k = landmarks.size();
+        const Distance* fromV = &fromLandmark[v * k];
+        const Distance* fromDest = &fromLandmark[dest * k];
+        const Distance* toV = &toLandmark[v * k];
+        const Distance* toDest = &toLandmark[dest * k];
+        Distance bound = 0;
+        for (size_t i = 0; i < k; ++i) {
+            // d(L,dest) <= d(L,v) + d(v,dest)
+            if (fromV[i] != infinity && fromDest[i] != infinity)
+                bound = std::max(bound, fromDest[i] - fromV[i]);
+            // d(v,L) <= d(v,dest) + d(dest,L)
+            if (toV[i] != infinity && toDest[i] != infinity)
+                bound = std::max(bound, toV[i] - toDest[i]);
+        }
+        return bound;
+    }
+
+    /**
+     * Dijkstra from source to every vertex it reaches, over the incoming edges if incoming is set,
+     * which gives the distances from every vertex to source. The distances are left in the workspace.
+     */
+    void Landmarks::distancesFrom(const Graph& g, size_t source, bool incoming, QueryWorkspace& workspace) {
+        workspace.reset(g.V());
+        HeapSearch<>(g, workspace, incoming ? EdgeDirection::INCOMING : EdgeDirection::OUTGOING)
+                .run(source, QueryWorkspace::NO_VERTEX);
+    }
+}
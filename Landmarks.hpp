@@ -0,0 +1,45 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef LANDMARKS_HPP
+#define LANDMARKS_HPP
+
+#include "Graph.hpp"
+#include "QueryWorkspace.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace ariel {
+
+    /**
+     * The distances from and to a few landmark vertices, for ALT search (A* with landmarks and the
+     * triangle inequality): for any landmark L, d(v,t) >= d(L,t) - d(L,v) and d(v,t) >= d(v,L) - d(t,L),
+     * so the largest of these differences is a lower bound on the distance from v to t that costs
+     * O(landmarks) to compute, and ShortestPath::Find searches towards t with it.
+     * The landmarks are picked by farthest point selection: every landmark is the vertex farthest
+     * from the ones picked before it, preferring the vertices none of them reach, so the landmarks
+     * end up on the edges of the graph, behind the vertices they bound.
+     * Vertices are named by their original numbers. The distances describe the graph as it was
+     * when they were computed, they must be computed again once it changes.
+     */
+    class Landmarks {
+    public:
+        Landmarks(const Graph& g, size_t count);
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] size_t numVertices() const;
+        [[nodiscard]] const std::vector<size_t>& vertices() const;
+        [[nodiscard]] Distance lowerBound(size_t v, size_t dest) const;
+
+    private:
+        std::vector<size_t> landmarks;
+        size_t n;
+        // the distances of vertex v from and to landmark i are at v * size() + i, so the bound
+        // reads two short runs of memory per vertex
+        std::vector<Distance> fromLandmark;
+        std::vector<Distance> toLandmark;
+
+        static void distancesFrom(const Graph& g, size_t source, bool incoming, QueryWorkspace& workspace);
+    };
+}
+
+#endif // LANDMARKS_HPP
@@ -0,0 +1,51 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ariel {
+
+    /**
+     * Maps the file at path.
+     * @throws std::runtime_error if the file can't be opened or mapped.
+     */
+    MappedFile::MappedFile(const std::string& path) : bytes(nullptr), length(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open graph file: " + path);
+        }
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Cannot read graph file: " + path);
+        }
+        length = static_cast<size_t>(status.st_size);
+        if (length > 0) {
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Cannot map graph file: " + path);
+            }
+            bytes = static_cast<const uint8_t*>(mapped);
+        }
+        // the mapping stays valid after the descriptor is closed
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (bytes != nullptr)
+            ::munmap(const_cast<uint8_t*>(bytes), length);
+    }
+
+    const uint8_t* MappedFile::data() const {
+        return bytes;
+    }
+
+    size_t MappedFile::size() const {
+        return length;
+    }
+}
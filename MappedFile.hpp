@@ -0,0 +1,33 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * A whole file mapped read-only into memory, unmapped when the object is destroyed.
+ * The pages are shared with every other process that maps the same file, and are only
+ * read from disk the first time they are touched.
+ */
+
+namespace ariel {
+    class MappedFile {
+    private:
+        const uint8_t* bytes;
+        size_t length;
+
+    public:
+        explicit MappedFile(const std::string& path);
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+        ~MappedFile();
+
+        [[nodiscard]] const uint8_t* data() const;
+        [[nodiscard]] size_t size() const;
+    };
+}
+
+#endif // MAPPED_FILE_HPP
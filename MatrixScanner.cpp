@@ -0,0 +1,150 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "MatrixScanner.hpp"
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ariel {
+
+    namespace {
+        const size_t BLOCK = 4;
+        // 64x64 cells of a tile and of its mirror tile take 32KB, about an L1 cache
+        const size_t TILE = 64;
+
+        void scanCell(Weight weight, MatrixSummary& summary) {
+            if (weight != 0) {
+                ++summary.numEdges;
+                if (weight != 1) {
+                    summary.weighted = true;
+                    if (weight < 0)
+                        summary.negative = true;
+                }
+            }
+        }
+
+        // portable version of the block pair scan, one cell at a time
+        template <typename T>
+        void scanBlockPair(const std::vector<const T*>& rows, size_t i, size_t j, MatrixSummary& summary) {
+            for (size_t a = i; a < i + BLOCK; ++a) {
+                for (size_t b = j; b < j + BLOCK; ++b) {
+                    scanCell(rows[a][b], summary);
+                    if (i != j)
+                        scanCell(rows[b][a], summary);
+                    if (summary.symmetric && rows[a][b] != rows[b][a])
+                        summary.symmetric = false;
+                }
+            }
+        }
+
+#if defined(__SSE2__)
+        const int ALL_LANES = 0xFFFF;
+
+        // counts the edges of a 4x4 block and looks for weighted and negative entries, 4 cells per compare
+        void scanBlock(const __m128i (&block)[BLOCK], MatrixSummary& summary) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i one = _mm_set1_epi32(1);
+            for (const __m128i& row : block) {
+                __m128i isZero = _mm_cmpeq_epi32(row, zero);
+                __m128i isOne = _mm_cmpeq_epi32(row, one);
+                int zeroBytes = _mm_movemask_epi8(isZero);
+                summary.numEdges += BLOCK - static_cast<size_t>(__builtin_popcount(static_cast<unsigned>(zeroBytes))) / 4;
+                if (_mm_movemask_epi8(_mm_or_si128(isZero, isOne)) != ALL_LANES)
+                    summary.weighted = true;
+                if (_mm_movemask_epi8(_mm_cmplt_epi32(row, zero)) != 0)
+                    summary.negative = true;
+            }
+        }
+
+        void transposeBlock(__m128i (&block)[BLOCK]) {
+            __m128i low01 = _mm_unpacklo_epi32(block[0], block[1]);
+            __m128i low23 = _mm_unpacklo_epi32(block[2], block[3]);
+            __m128i high01 = _mm_unpackhi_epi32(block[0], block[1]);
+            __m128i high23 = _mm_unpackhi_epi32(block[2], block[3]);
+            block[0] = _mm_unpacklo_epi64(low01, low23);
+            block[1] = _mm_unpackhi_epi64(low01, low23);
+            block[2] = _mm_unpacklo_epi64(high01, high23);
+            block[3] = _mm_unpackhi_epi64(high01, high23);
+        }
+
+        /**
+         * Scans the 4x4 block at (i,j) and its mirror at (j,i), and compares the first
+         * with the transpose of the second while the matrix may still be symmetric.
+         * Overload resolution prefers it to the portable template for 32 bit int weights.
+         */
+        void scanBlockPair(const std::vector<const int*>& rows, size_t i, size_t j, MatrixSummary& summary) {
+            __m128i upper[BLOCK];
+            __m128i lower[BLOCK];
+            for (size_t k = 0; k < BLOCK; ++k)
+                upper[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[i + k] + j));
+            scanBlock(upper, summary);
+
+            if (i == j) {
+                std::copy(upper, upper + BLOCK, lower);
+            } else {
+                for (size_t k = 0; k < BLOCK; ++k)
+                    lower[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[j + k] + i));
+                scanBlock(lower, summary);
+            }
+
+            if (summary.symmetric) {
+                transposeBlock(lower);
+                for (size_t k = 0; k < BLOCK; ++k) {
+                    if (_mm_movemask_epi8(_mm_cmpeq_epi32(upper[k], lower[k])) != ALL_LANES) {
+                        summary.symmetric = false;
+                        break;
+                    }
+                }
+            }
+        }
+#endif
+    }
+
+    /**
+     * Classifies a nested adjacency matrix in a single pass.
+     * @param matrix The adjacency matrix, assumed to be square.
+     * @return The number of edges, and whether the matrix is weighted, negative and symmetric.
+     */
+    MatrixSummary MatrixScanner::scan(const std::vector<std::vector<Weight>>& matrix) {
+        std::vector<const Weight*> rows;
+        rows.reserve(matrix.size());
+        for (const auto& row : matrix)
+            rows.push_back(row.data());
+        return scan(rows);
+    }
+
+    /**
+     * Classifies a square adjacency matrix given by its row pointers in a single pass.
+     * @param rows A pointer to every row, each one holding rows.size() cells.
+     * @return The number of edges, and whether the matrix is weighted, negative and symmetric.
+     */
+    MatrixSummary MatrixScanner::scan(const std::vector<const Weight*>& rows) {
+        MatrixSummary summary = {0, false, false, true};
+        size_t n = rows.size();
+        size_t blocked = n - n % BLOCK;
+
+        // the blocked part: tile pairs on and above the diagonal, each with its mirror below
+        for (size_t tileRow = 0; tileRow < blocked; tileRow += TILE) {
+            size_t rowEnd = std::min(tileRow + TILE, blocked);
+            for (size_t tileColumn = tileRow; tileColumn < blocked; tileColumn += TILE) {
+                size_t columnEnd = std::min(tileColumn + TILE, blocked);
+                for (size_t i = tileRow; i < rowEnd; i += BLOCK) {
+                    for (size_t j = tileColumn == tileRow ? i : tileColumn; j < columnEnd; j += BLOCK)
+                        scanBlockPair(rows, i, j, summary);
+                }
+            }
+        }
+
+        // the last n % 4 columns of the blocked rows, then the last n % 4 rows
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = i < blocked ? blocked : 0; j < n; ++j) {
+                scanCell(rows[i][j], summary);
+                if (summary.symmetric && rows[i][j] != rows[j][i])
+                    summary.symmetric = false;
+            }
+        }
+        return summary;
+    }
+}
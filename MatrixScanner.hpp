@@ -0,0 +1,36 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef MATRIX_SCANNER_HPP
+#define MATRIX_SCANNER_HPP
+
+#include "GraphProperties.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Single pass classification of a square adjacency matrix.
+ * The matrix is walked in cache sized tiles of 4x4 blocks: every block above the diagonal
+ * is loaded together with its mirror block below it, so edges are counted, weighted and
+ * negative entries detected, and symmetry checked (by transposing the mirror block in
+ * registers) while both blocks are in cache. Each pair of cells is compared once, and the
+ * comparison stops as soon as the matrix is known not to be symmetric.
+ * The blocks are compared with SSE2 when the weights are 32 bit ints, one cell at a time otherwise.
+ */
+
+namespace ariel {
+
+    struct MatrixSummary {
+        size_t numEdges;
+        bool weighted;
+        bool negative;
+        bool symmetric;
+    };
+
+    class MatrixScanner {
+    public:
+        static MatrixSummary scan(const std::vector<std::vector<Weight>>& matrix);
+        static MatrixSummary scan(const std::vector<const Weight*>& rows);
+    };
+}
+
+#endif // MATRIX_SCANNER_HPP
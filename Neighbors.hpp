@@ -0,0 +1,308 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef NEIGHBORS_HPP
+#define NEIGHBORS_HPP
+
+#include "GraphProperties.hpp"
+#include "SubgraphFilter.hpp"
+#include "Varint.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace ariel {
+
+    /**
+     * An outgoing edge as seen from its source vertex: the vertex it leads to and its weight.
+     */
+    struct Neighbor {
+        size_t vertex;
+        Weight weight;
+    };
+
+    /**
+     * Forward iterator over the outgoing edges of a single vertex, in increasing vertex order.
+     * Walks a row of whichever storage layout the graph uses: a sparse row (parallel target and
+     * weight arrays), a dense matrix row, skipping the zero cells, or a bit packed row,
+     * jumping from one set bit to the next.
+     * It can also walk a column of a dense or bit matrix, giving the incoming edges of a vertex
+     * (as the vertex they come from and their weight) without building the transposed matrix,
+     * or decode a compressed row one edge at a time.
+     */
+    class NeighborIterator {
+    public:
+        // iterator over a sparse row
+        NeighborIterator(const size_t* target, const Weight* weight)
+                : walk(Walk::SPARSE_ROW), target(target), weight(weight), row(nullptr), rows(nullptr),
+                  bits(nullptr), pending(0), column(0), columns(0), step(0), cursor(nullptr),
+                  decodedWeight(0), unitWeights(false) {}
+
+        // iterator over a dense row, positioned on the first edge at or after column
+        NeighborIterator(const Weight* row, size_t column, size_t columns)
+                : walk(Walk::DENSE_ROW), target(nullptr), weight(nullptr), row(row), rows(nullptr),
+                  bits(nullptr), pending(0), column(column), columns(columns), step(0), cursor(nullptr),
+                  decodedWeight(0), unitWeights(false) {
+            skipMissingEdges();
+        }
+
+        // iterator over a bit packed row of words, positioned on the first set bit of word
+        NeighborIterator(const uint64_t* bits, size_t word, size_t words)
+                : walk(Walk::BIT_ROW), target(nullptr), weight(nullptr), row(nullptr), rows(nullptr),
+                  bits(bits), pending(word < words ? bits[word] : 0), column(word), columns(words), step(0),
+                  cursor(nullptr), decodedWeight(0), unitWeights(false) {
+            skipEmptyWords();
+        }
+
+        // iterator down column v of a flat dense matrix whose rows start rowStride cells apart,
+        // positioned on the first edge at or after row first
+        NeighborIterator(const Weight* cells, size_t rowStride, size_t v, size_t first, size_t numRows)
+                : walk(Walk::DENSE_COLUMN), target(nullptr), weight(nullptr), row(cells + v), rows(nullptr),
+                  bits(nullptr), pending(0), column(first), columns(numRows), step(rowStride), cursor(nullptr),
+                  decodedWeight(0), unitWeights(false) {
+            skipMissingEdges();
+        }
+
+        // iterator down column v of a dense matrix given by its row pointers, positioned on the
+        // first edge at or after row first
+        NeighborIterator(const Weight* const* rows, size_t v, size_t first, size_t numRows)
+                : walk(Walk::ROW_TABLE_COLUMN), target(nullptr), weight(nullptr), row(nullptr), rows(rows),
+                  bits(nullptr), pending(0), column(first), columns(numRows), step(v), cursor(nullptr),
+                  decodedWeight(0), unitWeights(false) {
+            skipMissingEdges();
+        }
+
+        // iterator down column v of a bit matrix, positioned on the first edge at or after row first
+        NeighborIterator(const uint64_t* bits, size_t rowWords, size_t v, size_t first, size_t numRows)
+                : walk(Walk::BIT_COLUMN), target(nullptr), weight(nullptr), row(nullptr), rows(nullptr),
+                  bits(bits + v / 64), pending(uint64_t(1) << (v % 64)), column(first), columns(numRows),
+                  step(rowWords), cursor(nullptr), decodedWeight(0), unitWeights(false) {
+            skipMissingEdges();
+        }
+
+        // iterator over the count edges of the compressed row of u that start at encoded,
+        // positioned on (and already decoding) the first of them
+        NeighborIterator(const uint8_t* encoded, size_t u, size_t count, bool unitWeights)
+                : walk(Walk::COMPRESSED_ROW), target(nullptr), weight(nullptr), row(nullptr), rows(nullptr),
+                  bits(nullptr), pending(0), column(u), columns(count), step(0), cursor(encoded),
+                  decodedWeight(1), unitWeights(unitWeights) {
+            if (columns > 0) {
+                // the first target is stored relative to u, the others relative to the previous target
+                column = static_cast<size_t>(static_cast<int64_t>(u) + varint::unzigzag(varint::read(cursor)));
+                readWeight();
+            }
+        }
+
+        Neighbor operator*() const {
+            switch (walk) {
+                case Walk::DENSE_ROW:
+                    return Neighbor{column, row[column]};
+                case Walk::BIT_ROW:
+                    return Neighbor{column * 64 + static_cast<size_t>(__builtin_ctzll(pending)), 1};
+                case Walk::DENSE_COLUMN:
+                    return Neighbor{column, row[column * step]};
+                case Walk::ROW_TABLE_COLUMN:
+                    return Neighbor{column, rows[column][step]};
+                case Walk::BIT_COLUMN:
+                    return Neighbor{column, 1};
+                case Walk::COMPRESSED_ROW:
+                    return Neighbor{column, decodedWeight};
+                default:
+                    return Neighbor{*target, *weight};
+            }
+        }
+
+        NeighborIterator& operator++() {
+            switch (walk) {
+                case Walk::BIT_ROW:
+                    // clear the lowest set bit, move on to the next word once this one is exhausted
+                    pending &= pending - 1;
+                    skipEmptyWords();
+                    break;
+                case Walk::SPARSE_ROW:
+                    ++target;
+                    ++weight;
+                    break;
+                case Walk::COMPRESSED_ROW:
+                    if (--columns > 0) {
+                        column += 1 + static_cast<size_t>(varint::read(cursor));
+                        readWeight();
+                    }
+                    break;
+                default:
+                    ++column;
+                    skipMissingEdges();
+            }
+            return *this;
+        }
+
+        bool operator==(const NeighborIterator& other) const {
+            switch (walk) {
+                case Walk::BIT_ROW:
+                    return column == other.column && pending == other.pending;
+                case Walk::SPARSE_ROW:
+                    return target == other.target;
+                case Walk::COMPRESSED_ROW:
+                    return columns == other.columns;
+                default:
+                    return column == other.column;
+            }
+        }
+        bool operator!=(const NeighborIterator& other) const { return !(*this == other); }
+
+    private:
+        enum class Walk { SPARSE_ROW, DENSE_ROW, BIT_ROW, DENSE_COLUMN, ROW_TABLE_COLUMN, BIT_COLUMN, COMPRESSED_ROW };
+
+        Walk walk;
+        const size_t* target;
+        const Weight* weight;
+        const Weight* row;
+        const Weight* const* rows;
+        const uint64_t* bits;
+        uint64_t pending;
+        size_t column;
+        size_t columns;
+        // the cells per row of a dense column walk, the column read by a row table column walk,
+        // the words per row of a bit column walk
+        size_t step;
+        // a compressed walk keeps the decoded target in column and the edges left in columns
+        const uint8_t* cursor;
+        Weight decodedWeight;
+        bool unitWeights;
+
+        void readWeight() {
+            if (!unitWeights)
+                decodedWeight = varint::readWeight(cursor);
+        }
+
+        // moves column (the cell of a dense row, or the row of a column walk) to the next edge
+        void skipMissingEdges() {
+            switch (walk) {
+                case Walk::DENSE_COLUMN:
+                    while (column < columns && row[column * step] == 0)
+                        ++column;
+                    break;
+                case Walk::ROW_TABLE_COLUMN:
+                    while (column < columns && rows[column][step] == 0)
+                        ++column;
+                    break;
+                case Walk::BIT_COLUMN:
+                    while (column < columns && (bits[column * step] & pending) == 0)
+                        ++column;
+                    break;
+                default:
+                    while (column < columns && row[column] == 0)
+                        ++column;
+            }
+        }
+
+        void skipEmptyWords() {
+            while (pending == 0 && column < columns) {
+                ++column;
+                if (column < columns)
+                    pending = bits[column];
+            }
+        }
+    };
+
+    class NeighborRange;
+
+    /**
+     * Forward iterator around a walk of the storage, that skips the edges the filter of its range
+     * drops and renumbers the vertices as the view numbers them. Over a range without a filter it
+     * gives every edge of the walk as it is. The iterator is valid for as long as its range is.
+     */
+    class FilteredNeighborIterator {
+    public:
+        // iterator at current, a position of the walk of range, which is null without a filter
+        FilteredNeighborIterator(const NeighborIterator& current, const NeighborRange* range)
+                : current(current), range(range) {
+            skipFilteredEdges();
+        }
+
+        inline Neighbor operator*() const;
+
+        FilteredNeighborIterator& operator++() {
+            ++current;
+            skipFilteredEdges();
+            return *this;
+        }
+
+        bool operator==(const FilteredNeighborIterator& other) const { return current == other.current; }
+        bool operator!=(const FilteredNeighborIterator& other) const { return !(*this == other); }
+
+    private:
+        NeighborIterator current;
+        const NeighborRange* range;
+
+        inline void skipFilteredEdges();
+    };
+
+    /**
+     * The outgoing (or incoming) edges of a single vertex, usable in a range-based for loop.
+     */
+    class NeighborRange {
+    public:
+        // the count of a filtered range, whose edges are counted when its size is asked for
+        static constexpr size_t UNCOUNTED = std::numeric_limits<size_t>::max();
+
+        NeighborRange(NeighborIterator first, NeighborIterator last, size_t count)
+                : first(first), last(last), count(count), filter(nullptr), source(0), incoming(false) {}
+
+        // the edges of this range that filter keeps, this range walking the row (or with incoming, the
+        // column) of source, a vertex of the base graph of the filter; this range must not be filtered already
+        NeighborRange filtered(const SubgraphFilter* filter, size_t source, bool incoming) const {
+            NeighborRange range(first, last, UNCOUNTED);
+            range.filter = filter;
+            range.source = source;
+            range.incoming = incoming;
+            return range;
+        }
+
+        FilteredNeighborIterator begin() const { return FilteredNeighborIterator(first, filteredRange()); }
+        FilteredNeighborIterator end() const { return FilteredNeighborIterator(last, filteredRange()); }
+        size_t size() const {
+            if (count != UNCOUNTED)
+                return count;
+            size_t counted = 0;
+            for (FilteredNeighborIterator it = begin(); it != end(); ++it)
+                ++counted;
+            return counted;
+        }
+        bool empty() const { return count == UNCOUNTED ? begin() == end() : count == 0; }
+
+    private:
+        friend class FilteredNeighborIterator;
+
+        NeighborIterator first;
+        NeighborIterator last;
+        size_t count;
+        const SubgraphFilter* filter;
+        size_t source;
+        bool incoming;
+
+        const NeighborRange* filteredRange() const {
+            return filter != nullptr ? this : nullptr;
+        }
+
+        bool keeps(Neighbor edge) const {
+            return incoming ? filter->keeps(edge.vertex, source, edge.weight)
+                            : filter->keeps(source, edge.vertex, edge.weight);
+        }
+    };
+
+    Neighbor FilteredNeighborIterator::operator*() const {
+        Neighbor edge = *current;
+        if (range != nullptr)
+            edge.vertex = range->filter->localIds[edge.vertex];
+        return edge;
+    }
+
+    void FilteredNeighborIterator::skipFilteredEdges() {
+        if (range == nullptr)
+            return;
+        while (current != range->last && !range->keeps(*current))
+            ++current;
+    }
+}
+
+#endif // NEIGHBORS_HPP
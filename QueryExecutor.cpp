@@ -0,0 +1,122 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "QueryExecutor.hpp"
+#include "Algorithms.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace ariel {
+
+    /**
+     * Starts the threads of the pool, which wait for batches.
+     * @param numThreads The number of threads, by default one per core.
+     */
+    QueryExecutor::QueryExecutor(size_t numThreads)
+            : generation(0), busyWorkers(0), stopping(false), graph(nullptr), batch(nullptr), nextQuery(0) {
+        // hardware_concurrency is 0 when it can't tell
+        numThreads = std::max<size_t>(1, numThreads);
+        for (size_t i = 0; i < numThreads; ++i)
+            workers.emplace_back(&QueryExecutor::work, this);
+    }
+
+    /**
+     * Stops the threads once the batch being run (if any) is done.
+     */
+    QueryExecutor::~QueryExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+
+    /**
+     * Runs every query of a batch on the threads of the pool, and waits for all of them.
+     * The graph must not change until the batch is done. Batches run one at a time, a call made
+     * while another batch runs waits for it.
+     * @param g The graph to query.
+     * @param queries The queries, answered in any order.
+     * @return The answers in the order of the queries, and the time the batch took.
+     * @throws The exception of the first query (in batch order) that failed, once the batch is done,
+     *         std::invalid_argument for a shortest path between vertices out of range.
+     */
+    QueryBatchResult QueryExecutor::run(const Graph& g, const std::vector<Query>& queries) {
+        std::lock_guard<std::mutex> batchLock(batchMutex);
+        auto start = std::chrono::steady_clock::now();
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            this->graph = &g;
+            this->batch = &queries;
+            this->answers.assign(queries.size(), std::string());
+            this->errors.assign(queries.size(), nullptr);
+            this->nextQuery = 0;
+            this->busyWorkers = workers.size();
+            ++this->generation;
+            wake.notify_all();
+            finished.wait(lock, [this] { return busyWorkers == 0; });
+        }
+        auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (const std::exception_ptr& error : errors) {
+            if (error != nullptr)
+                std::rethrow_exception(error);
+        }
+        QueryBatchResult result;
+        result.answers = std::move(answers);
+        result.seconds = elapsed;
+        result.queriesPerSecond = elapsed > 0 ? static_cast<double>(queries.size()) / elapsed : 0;
+        return result;
+    }
+
+    size_t QueryExecutor::threads() const {
+        return workers.size();
+    }
+
+    /**
+     * The loop of every thread of the pool: wait for a batch, answer queries of it until none is
+     * left, report, and wait for the next one.
+     */
+    void QueryExecutor::work() {
+        QueryWorkspace workspace;
+        std::unique_lock<std::mutex> lock(mutex);
+        size_t seen = 0;
+        for (;;) {
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            lock.unlock();
+
+            // the queries are claimed one at a time, so a long one doesn't hold up the others
+            for (size_t i = nextQuery++; i < batch->size(); i = nextQuery++) {
+                try {
+                    answers[i] = answer(*graph, (*batch)[i], workspace);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+
+            lock.lock();
+            if (--busyWorkers == 0)
+                finished.notify_one();
+        }
+    }
+
+    std::string QueryExecutor::answer(const Graph& g, const Query& query, QueryWorkspace& workspace) {
+        switch (query.kind) {
+            case QueryKind::SHORTEST_PATH:
+                return Algorithms::shortestPath(g, query.source, query.dest, workspace);
+            case QueryKind::IS_CONNECTED:
+                return Algorithms::isConnected(g, workspace) ? "true" : "false";
+            case QueryKind::IS_BIPARTITE:
+                return Algorithms::isBipartite(g, workspace);
+            case QueryKind::CONTAINS_CYCLE:
+                return Algorithms::isContainsCycle(g, workspace);
+            default:
+                throw std::invalid_argument("Unknown query kind");
+        }
+    }
+}
@@ -0,0 +1,82 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef QUERY_EXECUTOR_HPP
+#define QUERY_EXECUTOR_HPP
+
+#include "Graph.hpp"
+#include "QueryWorkspace.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ariel {
+
+    enum class QueryKind { SHORTEST_PATH, IS_CONNECTED, IS_BIPARTITE, CONTAINS_CYCLE };
+
+    /**
+     * One query of a batch: the algorithm to run, and for a shortest path its two vertices.
+     */
+    struct Query {
+        QueryKind kind;
+        size_t source;
+        size_t dest;
+    };
+
+    /**
+     * The answers of a batch, in the order of its queries, and how fast it ran.
+     * A shortest path, bipartite or cycle query is answered with the string of its Algorithms
+     * method, a connectivity query with "true" or "false".
+     */
+    struct QueryBatchResult {
+        std::vector<std::string> answers;
+        double seconds;
+        double queriesPerSecond;
+    };
+
+    /**
+     * Runs batches of queries against a graph on a pool of threads, owned by the executor for its
+     * whole life. Every thread keeps its own QueryWorkspace, so once the workspaces have grown to the
+     * size of the graph the queries only allocate their answers.
+     * The algorithms only read the graph, and the graph computes its lazy properties and indexes
+     * once even when several threads ask for them, so any number of threads can query the same
+     * const graph, as long as nothing modifies it meanwhile (see VersionedGraph for that).
+     */
+    class QueryExecutor {
+    public:
+        explicit QueryExecutor(size_t numThreads = std::thread::hardware_concurrency());
+        ~QueryExecutor();
+        QueryExecutor(const QueryExecutor&) = delete;
+        QueryExecutor& operator=(const QueryExecutor&) = delete;
+
+        QueryBatchResult run(const Graph& g, const std::vector<Query>& queries);
+        [[nodiscard]] size_t threads() const;
+
+    private:
+        std::vector<std::thread> workers;
+        // one batch at a time
+        std::mutex batchMutex;
+
+        // the batch being run, guarded by mutex but for the queries the workers claim from nextQuery
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable finished;
+        size_t generation;
+        size_t busyWorkers;
+        bool stopping;
+        const Graph* graph;
+        const std::vector<Query>* batch;
+        std::vector<std::string> answers;
+        std::vector<std::exception_ptr> errors;
+        std::atomic<size_t> nextQuery;
+
+        void work();
+        static std::string answer(const Graph& g, const Query& query, QueryWorkspace& workspace);
+    };
+}
+
+#endif // QUERY_EXECUTOR_HPP
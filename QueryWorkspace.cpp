@@ -0,0 +1,64 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "QueryWorkspace.hpp"
+#include <algorithm>
+
+namespace ariel {
+
+    const size_t QueryWorkspace::NO_VERTEX;
+
+    /**
+     * Constructs an empty workspace, it grows on the first query.
+     */
+    QueryWorkspace::QueryWorkspace() : epoch(1) {}
+
+    /**
+     * Starts a new query on a graph of numVertices vertices: every vertex reads as fresh and
+     * the queues are emptied. O(1) unless the workspace has to grow.
+     */
+    void QueryWorkspace::reset(size_t numVertices) {
+        if (slots.size() < numVertices)
+            slots.resize(numVertices, Slot{0, 0, 0, NO_VERTEX});
+        clearVertices();
+        vertexQueue.clear();
+        vertexPath.clear();
+        distanceHeap.clear();
+        if (backwardSearch)
+            backwardSearch->reset(numVertices);
+    }
+
+    /**
+     * Makes every vertex read as fresh again in O(1), for a query that runs more than one
+     * search. The queues, the path and the heap are kept.
+     */
+    void QueryWorkspace::clearVertices() {
+        ++epoch;
+        if (epoch == 0) {
+            // the query numbers wrapped around, forget every old one
+            for (Slot& slot : slots)
+                slot.epoch = 0;
+            epoch = 1;
+        }
+    }
+
+    /**
+     * One of the two bitmaps (index 0 or 1) of the workspace, resized to words words, all zero.
+     */
+    std::vector<uint64_t>& QueryWorkspace::bitmap(size_t index, size_t words) {
+        std::vector<uint64_t>& bits = bitmaps[index];
+        bits.assign(words, 0);
+        return bits;
+    }
+
+    /**
+     * The workspace of the backward search of a query that searches from both of its ends, made on
+     * the first call. Every reset() of this workspace resets it too.
+     */
+    QueryWorkspace& QueryWorkspace::backward() {
+        if (!backwardSearch) {
+            backwardSearch.reset(new QueryWorkspace());
+            backwardSearch->reset(slots.size());
+        }
+        return *backwardSearch;
+    }
+}
@@ -0,0 +1,94 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef QUERY_WORKSPACE_HPP
+#define QUERY_WORKSPACE_HPP
+
+#include "GraphProperties.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ariel {
+
+    /**
+     * The scratch memory of the graph algorithms: a state, a distance and a parent for every vertex,
+     * and the queues, stacks and bitmaps of the searches. A thread that runs many queries keeps one
+     * workspace and passes it to every query, so once the workspace has grown to the size of the
+     * graph the queries don't allocate memory.
+     * Starting a new query costs O(1): every vertex slot carries the number of the query that last
+     * wrote it, and a slot written by an earlier query reads as a fresh one (state 0, infinite
+     * distance, no parent).
+     * A workspace must not be used by two queries at the same time.
+     */
+    class QueryWorkspace {
+    public:
+        static const size_t NO_VERTEX = std::numeric_limits<size_t>::max();
+
+        QueryWorkspace();
+
+        void reset(size_t numVertices);
+        void clearVertices();
+
+        [[nodiscard]] uint8_t state(size_t v) const {
+            return slots[v].epoch == epoch ? slots[v].state : 0;
+        }
+        void setState(size_t v, uint8_t state) {
+            touch(v).state = state;
+        }
+
+        [[nodiscard]] Distance distance(size_t v) const {
+            return slots[v].epoch == epoch ? slots[v].distance : std::numeric_limits<Distance>::max();
+        }
+        void setDistance(size_t v, Distance distance) {
+            touch(v).distance = distance;
+        }
+
+        [[nodiscard]] size_t parent(size_t v) const {
+            return slots[v].epoch == epoch ? slots[v].parent : NO_VERTEX;
+        }
+        void setParent(size_t v, size_t parent) {
+            touch(v).parent = parent;
+        }
+
+        // a queue or stack of vertices and a path, empty at the start of every query
+        std::vector<size_t>& queue() { return vertexQueue; }
+        std::vector<size_t>& path() { return vertexPath; }
+        // a binary min heap of (distance, vertex) pairs, empty at the start of every query
+        std::vector<std::pair<Distance, size_t>>& heap() { return distanceHeap; }
+        std::vector<uint64_t>& bitmap(size_t index, size_t words);
+        // a second workspace, for the backward half of a search from both ends, reset along with this one
+        QueryWorkspace& backward();
+
+    private:
+        struct Slot {
+            uint32_t epoch;
+            uint8_t state;
+            Distance distance;
+            size_t parent;
+        };
+
+        std::vector<Slot> slots;
+        uint32_t epoch;
+        std::vector<size_t> vertexQueue;
+        std::vector<size_t> vertexPath;
+        std::vector<std::pair<Distance, size_t>> distanceHeap;
+        std::vector<uint64_t> bitmaps[2];
+        std::unique_ptr<QueryWorkspace> backwardSearch;
+
+        Slot& touch(size_t v) {
+            Slot& slot = slots[v];
+            if (slot.epoch != epoch) {
+                slot.epoch = epoch;
+                slot.state = 0;
+                slot.distance = std::numeric_limits<Distance>::max();
+                slot.parent = NO_VERTEX;
+            }
+            return slot;
+        }
+    };
+}
+
+#endif // QUERY_WORKSPACE_HPP
@@ -2,6 +2,7 @@
 //EMAIL: idoavraham086@gmail.com
 
 #include "ShortestPath.hpp"
+#include "HeapSearch.hpp"
 
 namespace ariel {
 
@@ -14,115 +15,341 @@ namespace ariel {
      * @return A string describing the shortest path, or an error message if no path exists or input is invalid.
      */
     std::string ShortestPath::Execute(const ariel::Graph &g, size_t source, size_t dest) {
-        std::vector<size_t> shortestPath;
+        QueryWorkspace workspace;
+        return Execute(g, source, dest, workspace);
+    }
+
+    /**
+     * Finds the shortest path between two vertices in a graph, keeping its scratch memory in workspace.
+     * @param workspace Reused by every query of the calling thread, so the search doesn't allocate memory.
+     */
+    std::string ShortestPath::Execute(const ariel::Graph &g, size_t source, size_t dest, QueryWorkspace& workspace) {
+        return Execute(g, source, dest, PathOptions(), workspace);
+    }
+
+    /**
+     * Finds the shortest path between two vertices in a graph.
+     * @return The vertices of the path and its cost, or NO_PATH if dest can't be reached from source.
+     * @throws std::invalid_argument if the input is invalid or the graph has a negative cycle.
+     */
+    PathResult ShortestPath::Find(const ariel::Graph &g, size_t source, size_t dest) {
+        QueryWorkspace workspace;
+        return Find(g, source, dest, workspace);
+    }
+
+    /**
+     * Finds the shortest path between two vertices in a graph, keeping its scratch memory in workspace.
+     * Uses different algorithms based on the type of the graph.
+     * @param workspace Reused by every query of the calling thread, so only the result allocates memory.
+     */
+    PathResult ShortestPath::Find(const ariel::Graph &g, size_t source, size_t dest, QueryWorkspace& workspace) {
+        return Find(g, source, dest, PathOptions(), workspace);
+    }
+
+    /**
+     * Finds the shortest path between two vertices in a graph with the search options ask for.
+     * @return A string describing the shortest path, or a message if no path exists.
+     */
+    std::string ShortestPath::Execute(const ariel::Graph &g, size_t source, size_t dest, const PathOptions& options,
+                                      QueryWorkspace& workspace) {
+        bool searchedBack = false;
+        PathResult result = findPath(g, source, dest, options, workspace, searchedBack);
+        // the message of a path Bellman-Ford found from dest has always named dest first
+        if (searchedBack)
+            std::swap(result.source, result.dest);
+        return toMessage(result);
+    }
+
+    /**
+     * Finds the shortest path between two vertices in a graph with the search options ask for.
+     * A search other than the default one may pick another path than Find does when several are as short.
+     *
+     * A bidirectional search runs Dijkstra from both ends. A* settles the vertices in the order of their
+     * distance plus the heuristic's bound on their remaining distance, so it heads for dest instead of
+     * spreading evenly around source: the better the bound, the smaller the part of the graph it searches.
+     * ALT search is A* with the bounds that the distances from and to the landmarks give.
+     * @param options The search, see PathOptions.
+     * @throws std::invalid_argument if the input is invalid, the options ask for more than one search,
+     *         the search needs non-negative weights and the graph has negative ones, or the landmarks
+     *         were computed on a graph of another size.
+     */
+    PathResult ShortestPath::Find(const ariel::Graph &g, size_t source, size_t dest, const PathOptions& options,
+                                  QueryWorkspace& workspace) {
+        bool searchedBack = false;
+        return findPath(g, source, dest, options, workspace, searchedBack);
+    }
+
+    /**
+     * The search of Find.
+     * @param searchedBack Set if the path was found by searching from dest to source, which only
+     *        Bellman-Ford does, on undirected graphs.
+     */
+    PathResult ShortestPath::findPath(const ariel::Graph &g, size_t source, size_t dest, const PathOptions& options,
+                                      QueryWorkspace& workspace, bool& searchedBack) {
         if (!isValidInput(g, source, dest))
              throw std::invalid_argument("Invalid input for finding shortest path");
+        bool bidirectional = options.search != PathSearch::AUTOMATIC;
+        bool guided = options.heuristic || options.landmarks != nullptr;
+        if ((bidirectional && guided) || (options.heuristic && options.landmarks != nullptr))
+            throw std::invalid_argument("The options ask for more than one search");
+        if ((bidirectional || guided) && g.getEdgeNegativity() == EdgeNegativity::NEGATIVE)
+            throw std::invalid_argument("The search needs a graph without negative weights");
+        if (options.landmarks != nullptr && options.landmarks->numVertices() != g.V())
+            throw std::invalid_argument("The landmarks belong to another graph");
+
+        // the caller numbers the vertices as they were before the graph was reordered, and so do
+        // the heuristic and the landmarks
+        size_t originalDest = dest;
+        source = g.internalId(source);
+        dest = g.internalId(dest);
+        workspace.reset(g.V());
+        std::vector<size_t>& shortestPath = workspace.path();
+        size_t settled;
+
+        if (bidirectional) {
+            Distance cost = 0;
+            settled = bidirectionalDijkstra(g, source, dest, workspace, shortestPath, cost);
+            return constructPath(g, shortestPath, source, dest, cost, settled);
+        }
+        if (options.heuristic) {
+            const PathHeuristic& heuristic = options.heuristic;
+            settled = aStar(g, source, dest, [&g, &heuristic, originalDest](size_t v) {
+                return heuristic(g.originalId(v), originalDest);
+            }, workspace, shortestPath);
+            return constructPath(g, shortestPath, source, dest, workspace.distance(dest), settled);
+        }
+        if (options.landmarks != nullptr) {
+            const Landmarks& landmarks = *options.landmarks;
+            settled = aStar(g, source, dest, [&g, &landmarks, originalDest](size_t v) {
+                return landmarks.lowerBound(g.originalId(v), originalDest);
+            }, workspace, shortestPath);
+            return constructPath(g, shortestPath, source, dest, workspace.distance(dest), settled);
+        }
 
         switch (g.getEdgeNegativity()) {
             case EdgeNegativity::NEGATIVE:
                 // Use Bellman-Ford algorithm for graphs with negative weights
-                return bellmanFordSetUps(g,source,dest);
+                return bellmanFordSetUps(g, source, dest, workspace, searchedBack);
             default:
                 // Check for unweighted, weighted, or unknown graphs
                 switch (g.getEdgeType()) {
                     case EdgeType::WEIGHTED:
                         // Use Dijkstra's algorithm for weighted graphs with non-negative weights
-                        shortestPath = dijkstra(g, source, dest);
-                        break;
+                        settled = dijkstra(g, source, dest, workspace, shortestPath);
+                        return constructPath(g, shortestPath, source, dest, workspace.distance(dest), settled);
                     case EdgeType::UNWEIGHTED:
-                        // Use BFS for unweighted graphs
-                        shortestPath = bfs(g, source, dest);
-                        break;
+                        // Use BFS for unweighted graphs, where every edge weighs 1
+                        settled = bfs(g, source, dest, workspace, shortestPath);
+                        return constructPath(g, shortestPath, source, dest,
+                                             static_cast<Distance>(shortestPath.size()) - 1, settled);
                     default:
                         // Handle unknown edge types
                         throw std::runtime_error("Unknown graph type encountered");
                 }
         }
-        // check if a path was found
-        if( shortestPath.empty())
-            return "There is no path from " + std::to_string(source) + " to " + std::to_string(dest);
-
-        return constructPath(shortestPath,source,dest);
     }
 
 
-    // finding the shortest path from source to dest using dijkstra's algorithm
-    std::vector<size_t> ShortestPath::dijkstra(const Graph &g, size_t source, size_t dest) {
-        // init the predecessors array to infinity to indicate no pred
-        std::vector<size_t> predecessors(g.V(), std::numeric_limits<size_t>::max());
-        // init the distance array to infinity for each vertex
-        std::vector<int> dist(g.V(), std::numeric_limits<int>::max());
-        dist[source] = 0;
-        // create a priority que to store the distance from source of each vertex
-        std::priority_queue<std::pair<int, size_t>, std::vector<std::pair<int, size_t>>,
-                    std::greater<std::pair<int, size_t>>> pq;
-        // insert source vertex with distance 0 to the pq
-        pq.emplace(0, source);
-
-        while (!pq.empty()) {
-            //extract the vertex with the min distance
-            int dist_u = pq.top().first;
-            size_t u = pq.top().second;
-            pq.pop();
-
-            // relax all the adj of u if necessary
-            for (size_t v = 0; v < g.V(); v++) {
-
-                int weight_uv = g.getEdgeWeight(u, v);
-
-                if (weight_uv != 0) {
-                    if (dist[v] > dist_u + weight_uv) {
-                        dist[v] = dist_u + weight_uv;
-                        predecessors[v] = u;
-                        pq.emplace(dist[v], v);
-                    }
-                }
+    /**
+     * Finds the shortest paths from a source to every vertex, to answer many destinations of one source.
+     * @param g The graph in which to find the shortest paths.
+     * @param source The source vertex.
+     * @return The distance and the predecessor of every vertex, see ShortestPathTree.
+     * @throws std::invalid_argument if the source is out of range or the graph has a negative cycle.
+     */
+    ShortestPathTree ShortestPath::FindTree(const ariel::Graph &g, size_t source) {
+        QueryWorkspace workspace;
+        return FindTree(g, source, workspace);
+    }
+
+    /**
+     * Finds the shortest paths from a source to every vertex, keeping the scratch memory of the
+     * search in workspace. The search is the one Find picks for the graph, run until every vertex
+     * it reaches is settled, and its predecessors are kept instead of read back from the distances.
+     * On an undirected graph with negative weights, the paths are the ones Bellman-Ford finds from
+     * the source, which may differ from Find's: Find also searches back from the destination.
+     */
+    ShortestPathTree ShortestPath::FindTree(const ariel::Graph &g, size_t source, QueryWorkspace& workspace) {
+        if (!isValidInput(g, source, source))
+            throw std::invalid_argument("Invalid input for finding shortest path");
+
+        size_t root = g.internalId(source);
+        workspace.reset(g.V());
+        ShortestPathTree tree(source, g.V());
+
+        if (g.getEdgeNegativity() != EdgeNegativity::NEGATIVE && g.getEdgeType() == EdgeType::UNWEIGHTED) {
+            // BFS keeps no distances, but its queue lists the vertices in the order they were
+            // reached, each after its parent
+            bfsSearch(g, root, QueryWorkspace::NO_VERTEX, workspace);
+            const std::vector<size_t>& order = workspace.queue();
+            for (size_t i = 1; i < order.size(); ++i) {
+                size_t v = g.originalId(order[i]);
+                size_t parent = g.originalId(workspace.parent(order[i]));
+                tree.distances[v] = tree.distances[parent] + 1;
+                tree.parents[v] = parent;
             }
+            return tree;
         }
+
+        // Dijkstra runs to the end without a destination, Bellman-Ford always does
+        if (g.getEdgeNegativity() == EdgeNegativity::NEGATIVE)
+            bellmanFord(g, root, root, workspace, workspace.path());
+        else
+            dijkstra(g, root, QueryWorkspace::NO_VERTEX, workspace, workspace.path());
+        for (size_t v = 0; v < g.V(); ++v) {
+            if (v == root || workspace.parent(v) == QueryWorkspace::NO_VERTEX)
+                continue;
+            tree.distances[g.originalId(v)] = workspace.distance(v);
+            tree.parents[g.originalId(v)] = g.originalId(workspace.parent(v));
+        }
+        return tree;
+    }
+
+
+    // finding the shortest path from source to dest using dijkstra's algorithm, which stops once dest is
+    // settled, or settles every vertex source reaches if dest is NO_VERTEX
+    // the distances, predecessors and the heap live in the workspace
+    // returns the number of vertices settled
+    size_t ShortestPath::dijkstra(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                  std::vector<size_t>& path) {
+        size_t settled = HeapSearch<>(g, workspace, EdgeDirection::OUTGOING).run(source, dest);
         // check if there is path
-        if (predecessors[dest] == std::numeric_limits<size_t>::max())
-            return {};
+        if (dest == QueryWorkspace::NO_VERTEX || workspace.parent(dest) == QueryWorkspace::NO_VERTEX)
+            return settled;
 
+        buildShortestPath(workspace, source, dest, path);
+        return settled;
+    }
 
-        return buildShortestPath(g,dist,source,dest);
+    namespace {
+        // the key of A*, distance plus the bound on the rest of the way, which is estimated once per
+        // vertex and kept as the distance of the vertex in bounds
+        template <typename Estimate>
+        struct BoundedKey {
+            const Estimate& estimate;
+            QueryWorkspace& bounds;
+
+            Distance operator()(size_t v, Distance distance) const {
+                if (bounds.state(v) == 0) {
+                    bounds.setState(v, 1);
+                    bounds.setDistance(v, estimate(v));
+                }
+                return distance + bounds.distance(v);
+            }
+        };
+    }
 
+    /**
+     * A* search, the heap search keyed by distance plus bound, with the bounds kept in the backward
+     * half of the workspace. A vertex is searched again if a shorter distance to it turns up later,
+     * so the bound only has to be admissible, not consistent, and the distance of dest is final once
+     * dest leaves the heap. With a bound of 0 it is Dijkstra.
+     * @return The number of vertices settled.
+     */
+    template <typename Estimate>
+    size_t ShortestPath::aStar(const Graph &g, size_t source, size_t dest, const Estimate& estimate,
+                               QueryWorkspace& workspace, std::vector<size_t>& path) {
+        BoundedKey<Estimate> key{estimate, workspace.backward()};
+        size_t settled = HeapSearch<BoundedKey<Estimate>>(g, workspace, EdgeDirection::OUTGOING, key).run(source, dest);
+        // like dijkstra, a vertex has no path to itself
+        if (workspace.parent(dest) != QueryWorkspace::NO_VERTEX)
+            buildShortestPath(workspace, source, dest, path);
+        return settled;
+    }
+
+    /**
+     * Dijkstra's algorithm from both ends at once: forward from source over the outgoing edges, and
+     * backward from dest over the incoming edges, each side in its own half of the workspace. The side
+     * whose heap has the smaller top settles its next vertex, and every edge it relaxes into a vertex
+     * the other side has reached is a candidate for the shortest path. Once the two tops add up to
+     * at least the shortest candidate, no path through an unsettled vertex can be shorter, so each
+     * side searches about half the distance, a much smaller part of the graph than a single search.
+     * @param cost Set to the length of the path found.
+     * @return The number of vertices the two sides settled.
+     */
+    size_t ShortestPath::bidirectionalDijkstra(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                               std::vector<size_t>& path, Distance& cost) {
+        // like dijkstra, a vertex has no path to itself
+        if (source == dest)
+            return 0;
+
+        QueryWorkspace* sides[2] = {&workspace, &workspace.backward()};
+        HeapSearch<> forward(g, *sides[0], EdgeDirection::OUTGOING);
+        HeapSearch<> backward(g, *sides[1], EdgeDirection::INCOMING);
+        HeapSearch<>* searches[2] = {&forward, &backward};
+        forward.start(source);
+        backward.start(dest);
+        Distance best = std::numeric_limits<Distance>::max();
+        size_t meeting = QueryWorkspace::NO_VERTEX;
+
+        while (!forward.empty() && !backward.empty()) {
+            if (best != std::numeric_limits<Distance>::max() && forward.topKey() + backward.topKey() >= best)
+                break;
+
+            size_t side = forward.topKey() <= backward.topKey() ? 0 : 1;
+            const QueryWorkspace& self = *sides[side];
+            const QueryWorkspace& other = *sides[1 - side];
+            size_t u = searches[side]->settleNext();
+            if (u == QueryWorkspace::NO_VERTEX)
+                break;
+            searches[side]->relax(u, [&self, &other, &best, &meeting](size_t v) {
+                // a path from source to dest through the edge
+                Distance rest = other.distance(v);
+                if (rest != std::numeric_limits<Distance>::max() && self.distance(v) + rest < best) {
+                    best = self.distance(v) + rest;
+                    meeting = v;
+                }
+            });
+        }
+        size_t settled = forward.settled() + backward.settled();
+        if (meeting == QueryWorkspace::NO_VERTEX)
+            return settled;
+
+        // the forward parents lead back to source, the backward parents on to dest
+        buildShortestPath(*sides[0], source, meeting, path);
+        for (size_t v = sides[1]->parent(meeting); v != QueryWorkspace::NO_VERTEX; v = sides[1]->parent(v))
+            path.push_back(v);
+        cost = best;
+        return settled;
     }
 
     // finding the shortest path from source to dest using bellman-ford's algorithm
-    std::vector<size_t> ShortestPath::bellmanFord(const Graph &g, size_t source, size_t dest) {
-        // Initialize predecessors with a special value (-1) to indicate no predecessor
-        std::vector<size_t > predecessors(g.V(), size_t(-1));
-        // Initialize distances with infinity
-        std::vector<int> dist(g.V(), std::numeric_limits<int>::max());
-        dist[source] = 0;
+    // every vertex of the workspace starts with no predecessor and an infinite distance
+    void ShortestPath::bellmanFord(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                   std::vector<size_t>& path) {
+        workspace.setDistance(source, 0);
 
         // Iterating |V| - 1 times
         for (int i = 0; i < g.V() - 1; i++) {
             // Iterate through each edge in the graph
             for (size_t u = 0; u < g.V(); u++) {
-                for (size_t v = 0; v < g.V(); v++) {
+                for (Neighbor edge : g.neighbors(u)) {
                     // Perform relaxation on the edge u,v
-                    int weight_uv = g.getEdgeWeight(u, v);
-                    // Relax the edge if it exists and a shorter path is found
-                    if (weight_uv != 0 && dist[v] > weight_uv + dist[u] && dist[u] != std::numeric_limits<int>::max()) {
+                    size_t v = edge.vertex;
+                    Weight weight_uv = edge.weight;
+                    Distance dist_u = workspace.distance(u);
+                    // Relax the edge if a shorter path is found
+                    if (dist_u != std::numeric_limits<Distance>::max() && workspace.distance(v) > weight_uv + dist_u) {
                         // in undirected graphs, use negative edge only once to relax
-                        if(g.getGraphType()==GraphType::UNDIRECTED && predecessors[u] == v) {
+                        if(g.getGraphType()==GraphType::UNDIRECTED && workspace.parent(u) == v) {
                             continue;
                         }
-                        dist[v] = weight_uv + dist[u];
-                        predecessors[v] = u;
+                        workspace.setDistance(v, weight_uv + dist_u);
+                        workspace.setParent(v, u);
                     }
                 }
             }
         }
         // Check for negative cycles according to the graph type
         for (size_t u = 0; u < g.V(); ++u) {
-            for (size_t v = 0; v < g.V(); ++v) {
-                int weight_uv = g.getEdgeWeight(u, v);
-                if (weight_uv != 0 &&  dist[u] != std::numeric_limits<int>::max()  && dist[u] + weight_uv < dist[v] ) {
+            for (Neighbor edge : g.neighbors(u)) {
+                size_t v = edge.vertex;
+                Weight weight_uv = edge.weight;
+                Distance dist_u = workspace.distance(u);
+                if (dist_u != std::numeric_limits<Distance>::max()  && dist_u + weight_uv < workspace.distance(v) ) {
 
                     // ignore negative cycle with size 1 in undirected graphs
-                    if(g.getGraphType()==GraphType::UNDIRECTED && predecessors[u] == v)
+                    if(g.getGraphType()==GraphType::UNDIRECTED && workspace.parent(u) == v)
                         continue;
 
                     // Negative cycle detected
@@ -130,60 +357,100 @@ namespace ariel {
                 }
             }
         }
-        // return the shortest path vector
-        return buildShortestPath(g,dist,source,dest);
-
+        // leave the path empty if dest can't be reached
+        if (workspace.distance(dest) == std::numeric_limits<Distance>::max())
+            return;
+        buildShortestPath(workspace, source, dest, path);
     }
 
-    // finding the shortest path from source to dest using bds
-    std::vector<size_t> ShortestPath::bfs(const Graph &g, size_t source, size_t dest) {
-        // Array of the parent of each node
-        std::vector<size_t> parents(g.V(), std::numeric_limits<size_t>::max());
-        // Array to indicate if a node was visited during the traversal
-        std::vector<bool> visited(g.V(), false);
-        std::queue<size_t> q;
+    // finding the shortest path from source to dest using bds, returns the number of vertices dequeued
+    size_t ShortestPath::bfs(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace,
+                             std::vector<size_t>& path) {
+        size_t settled = bfsSearch(g, source, dest, workspace);
 
-        visited[source] = true;
-        q.push(source);
+        // Check if the destination vertex was reached, leave the path empty if not
+        if (workspace.parent(dest) == QueryWorkspace::NO_VERTEX) {
+            return settled;
+        }
 
-        while (!q.empty()) {
-            size_t current = q.front();
-            q.pop();
+        // Reconstruct the shortest path by backtracking from the destination to the source
+        buildShortestPath(workspace, source, dest, path);
+        return settled;
+    }
 
-            // Check if the destination vertex is reached
-            if (current == dest) {
-                break; // Stop BFS traversal
-            }
+    // BFS from source until dest is dequeued, or over everything source reaches if dest is NO_VERTEX
+    // the parents, the visited marks (state 1) and the queue, in BFS order, live in the workspace
+    // returns the number of vertices dequeued
+    size_t ShortestPath::bfsSearch(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace) {
+        if (g.getStorageLayout() == StorageLayout::BITSET) {
+            return bfsBitParallel(g, source, dest, workspace);
+        } else {
+            std::vector<size_t>& q = workspace.queue();
+            size_t head = 0;
+
+            workspace.setState(source, 1);
+            q.push_back(source);
+
+            while (head < q.size()) {
+                size_t current = q[head++];
+
+                // Check if the destination vertex is reached
+                if (current == dest) {
+                    break; // Stop BFS traversal
+                }
 
-            // Enqueue neighboring vertices
-            for (size_t neighbor = 0; neighbor < g.V(); ++neighbor) {
-                if (!visited[neighbor] && g.getEdgeWeight(current, neighbor) != 0) {
-                    visited[neighbor] = true;
-                    parents[neighbor] = current;
-                    q.push(neighbor);
+                // Enqueue neighboring vertices
+                for (Neighbor edge : g.neighbors(current)) {
+                    size_t neighbor = edge.vertex;
+                    if (workspace.state(neighbor) == 0) {
+                        workspace.setState(neighbor, 1);
+                        workspace.setParent(neighbor, current);
+                        q.push_back(neighbor);
+                    }
                 }
             }
+            return head;
         }
-        // Check if the destination vertex was reached
-        if (parents[dest] == std::numeric_limits<size_t>::max()) {
-            return {}; // Return an empty vector if no path exists
-        }
+    }
 
-        // Reconstruct the shortest path using the parent's array
-        std::vector<size_t> shortestPath;
-        size_t currentVertex = dest;
+    /**
+     * BFS from source over a bit matrix, filling the parent of every reached vertex.
+     * Returns the number of vertices dequeued.
+     * Each dequeued vertex is expanded a word at a time: row & ~visited gives all of its
+     * unvisited neighbors among 64 vertices at once. Vertices are enqueued in increasing
+     * order, so the parents are the same ones the plain BFS picks.
+     */
+    size_t ShortestPath::bfsBitParallel(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace) {
+        size_t words = g.adjacencyWords();
+        std::vector<uint64_t>& visited = workspace.bitmap(0, words);
+        std::vector<size_t>& q = workspace.queue();
+        size_t head = 0;
 
-        // Reconstruct the shortest path by backtracking from the destination to the source
-        while (currentVertex != source) {
-            shortestPath.push_back(currentVertex);
-            currentVertex = parents[currentVertex];
-        }
-        shortestPath.push_back(source);
+        visited[source / 64] |= uint64_t(1) << (source % 64);
+        q.push_back(source);
 
-        // Reverse the path to get it in the correct order (from source to destination)
-        std::reverse(shortestPath.begin(), shortestPath.end());
+        while (head < q.size()) {
+            size_t current = q[head++];
 
-        return shortestPath;
+            // Check if the destination vertex is reached
+            if (current == dest) {
+                break;
+            }
+
+            const uint64_t* row = g.adjacencyBits(current);
+            for (size_t w = 0; w < words; ++w) {
+                uint64_t discovered = row[w] & ~visited[w];
+                visited[w] |= discovered;
+                // enqueue the new vertices of this word, lowest first
+                while (discovered != 0) {
+                    size_t neighbor = w * 64 + static_cast<size_t>(__builtin_ctzll(discovered));
+                    workspace.setParent(neighbor, current);
+                    q.push_back(neighbor);
+                    discovered &= discovered - 1;
+                }
+            }
+        }
+        return head;
     }
 
     // Checks if the input parameters are valid for finding the shortest path.
@@ -203,71 +470,78 @@ namespace ariel {
         return true; // Valid input
     }
 
-    std::string ShortestPath::bellmanFordSetUps(const Graph &g, size_t source, size_t dest) {
+    PathResult ShortestPath::bellmanFordSetUps(const Graph &g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                               bool& searchedBack) {
 
         // find the shortest path from source vx to the dest vx
-        std::vector<size_t> pathFromSourceToDest= bellmanFord(g,source,dest);
-
-         if( pathFromSourceToDest.empty())
-            return "There is no path from " + std::to_string(source) + " to " + std::to_string(dest);
+        std::vector<size_t>& pathFromSourceToDest = workspace.path();
+        bellmanFord(g, source, dest, workspace, pathFromSourceToDest);
 
-        if(g.getGraphType() == GraphType::DIRECTED)
-            return constructPath(pathFromSourceToDest,source,dest);
+        if (pathFromSourceToDest.empty() || g.getGraphType() == GraphType::DIRECTED)
+            return constructPath(g, pathFromSourceToDest, source, dest, workspace.distance(dest), g.V());
 
         // handle undirected graphs
         else {
-            // find the shortest path from dest vx to the source vx
-            std::vector<size_t> pathFromDestToSource = bellmanFord(g, dest, source);
+            // find the shortest path from dest vx to the source vx, in the queue of the
+            // workspace, which Bellman-Ford doesn't use otherwise
+            std::vector<size_t>& pathFromDestToSource = workspace.queue();
+            workspace.clearVertices();
+            bellmanFord(g, dest, source, workspace, pathFromDestToSource);
 
             // find the cheaper path, and return it
-            int weightFromSourceToDest = CalculatePathCost(pathFromSourceToDest, g);
-            int weightFromDestToSource = CalculatePathCost(pathFromDestToSource, g);
+            Distance weightFromSourceToDest = CalculatePathCost(pathFromSourceToDest, g);
+            Distance weightFromDestToSource = CalculatePathCost(pathFromDestToSource, g);
 
             if (weightFromSourceToDest < weightFromDestToSource)
-                return constructPath(pathFromSourceToDest,source,dest);
+                return constructPath(g, pathFromSourceToDest, source, dest, weightFromSourceToDest, 2 * g.V());
 
             reverse(pathFromDestToSource.begin(), pathFromDestToSource.end());
-            return constructPath(pathFromDestToSource, dest , source);
+            searchedBack = true;
+            return constructPath(g, pathFromDestToSource, source, dest, weightFromDestToSource, 2 * g.V());
         }
 
     }
 
-    std::string ShortestPath::constructPath(const std::vector<size_t> &path,size_t source, size_t dest) {
-        std::string pathAsString = std::to_string(path.at(0));
-        for (size_t i = 1; i < path.size(); ++i) {
-            pathAsString += "->" + std::to_string(path.at(i));
+    // the path is reported with the original numbers of its vertices
+    PathResult ShortestPath::constructPath(const Graph &g, const std::vector<size_t> &path, size_t source, size_t dest,
+                                           Distance cost, size_t settled) {
+        PathResult result;
+        result.source = g.originalId(source);
+        result.dest = g.originalId(dest);
+        result.settled = settled;
+        if (path.empty()) {
+            result.status = PathStatus::NO_PATH;
+            result.cost = 0;
+            return result;
         }
-        return "Shortest path from " + std::to_string(source) + " to " + std::to_string(dest) + " is: " + pathAsString;
+        result.status = PathStatus::FOUND;
+        result.cost = cost;
+        result.vertices.reserve(path.size());
+        for (size_t v : path)
+            result.vertices.push_back(g.originalId(v));
+        return result;
     }
 
-    int ShortestPath::CalculatePathCost(std::vector<size_t> &path, const Graph &g) {
-        int totalCost = 0;
+    Distance ShortestPath::CalculatePathCost(std::vector<size_t> &path, const Graph &g) {
+        Distance totalCost = 0;
         for (size_t i = 0; i < path.size() - 1; ++i) {
-            int current_Edge = g.getEdgeWeight(path[i],path[i+1]);
+            Weight current_Edge = g.getEdgeWeight(path[i],path[i+1]);
             totalCost += current_Edge;
         }
         return totalCost;
     }
 
-    std::vector<size_t> ShortestPath::buildShortestPath(const Graph &g, std::vector<int> &dist ,  size_t source ,size_t dest) {
+    // walks the parents the search recorded back from dest, which it reached, to source
+    void ShortestPath::buildShortestPath(const QueryWorkspace& workspace, size_t source, size_t dest,
+                                         std::vector<size_t>& path) {
         // Build the shortest path vector
-        std::vector<size_t> shortestPath;
         size_t currentVertex = dest;
         while (currentVertex != source) {
-            shortestPath.push_back(currentVertex);
-            for (size_t u = 0; u < g.V(); ++u) {
-                int Edge_u_current =g.getEdgeWeight(u,size_t(currentVertex));
-                if (Edge_u_current != 0 &&
-                    dist[u] + Edge_u_current == dist[size_t(currentVertex)]) {
-                    currentVertex = u;
-                    break;
-                }
-            }
+            path.push_back(currentVertex);
+            currentVertex = workspace.parent(currentVertex);
         }
-        shortestPath.push_back(source);
-        reverse(shortestPath.begin(), shortestPath.end());
-
-        return shortestPath;
+        path.push_back(source);
+        reverse(path.begin(), path.end());
     }
 
 
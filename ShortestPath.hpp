@@ -3,7 +3,11 @@
 #ifndef SHORTEST_PATH_HPP
 #define SHORTEST_PATH_HPP
 
+#include "AlgorithmResults.hpp"
 #include "Graph.hpp"
+#include "Landmarks.hpp"
+#include "QueryWorkspace.hpp"
+#include "ShortestPathTree.hpp"
 #include <stack>
 #include "iostream"
 #include <vector>
@@ -11,32 +15,92 @@
 #include <limits>
 #include <sstream>
 #include <algorithm>
+#include <functional>
 
 namespace ariel {
+
+    // how a shortest path is searched for in a graph without negative weights: AUTOMATIC picks BFS for
+    // unweighted graphs and Dijkstra for weighted ones, BIDIRECTIONAL runs Dijkstra from both ends
+    enum class PathSearch { AUTOMATIC, BIDIRECTIONAL };
+
+    // a lower bound on the distance from a vertex to a destination, for A* search: it takes the vertex
+    // and then the destination, by their original numbers, and must never return more than their distance
+    typedef std::function<Distance(size_t, size_t)> PathHeuristic;
+
+    /**
+     * How a shortest path is searched for. By default the search is picked by the graph; search asks
+     * for a bidirectional one, and a heuristic or landmarks for an A* search guided by them. At most
+     * one of these can be given, and all of them need a graph without negative weights.
+     */
+    struct PathOptions {
+        PathSearch search;
+        PathHeuristic heuristic;
+        // landmarks of the graph, computed since its last change, for ALT search; they must outlive the query
+        const Landmarks* landmarks;
+
+        PathOptions() : search(PathSearch::AUTOMATIC), landmarks(nullptr) {}
+        explicit PathOptions(PathSearch search) : search(search), landmarks(nullptr) {}
+        explicit PathOptions(PathHeuristic heuristic)
+                : search(PathSearch::AUTOMATIC), heuristic(std::move(heuristic)), landmarks(nullptr) {}
+        explicit PathOptions(const Landmarks& landmarks) : search(PathSearch::AUTOMATIC), landmarks(&landmarks) {}
+    };
+
     class ShortestPath {
     public:
         static std::string Execute(const ariel::Graph &g, size_t source, size_t dest);
+        static std::string Execute(const ariel::Graph &g, size_t source, size_t dest, QueryWorkspace& workspace);
+        static std::string Execute(const ariel::Graph &g, size_t source, size_t dest, const PathOptions& options,
+                                   QueryWorkspace& workspace);
+        static PathResult Find(const ariel::Graph &g, size_t source, size_t dest);
+        static PathResult Find(const ariel::Graph &g, size_t source, size_t dest, QueryWorkspace& workspace);
+        static PathResult Find(const ariel::Graph &g, size_t source, size_t dest, const PathOptions& options,
+                               QueryWorkspace& workspace);
+        static ShortestPathTree FindTree(const ariel::Graph &g, size_t source);
+        static ShortestPathTree FindTree(const ariel::Graph &g, size_t source, QueryWorkspace& workspace);
 
     private:
 
-        static std::string bellmanFordSetUps(const Graph& g, size_t source, size_t dest);
+        static PathResult findPath(const Graph& g, size_t source, size_t dest, const PathOptions& options,
+                                   QueryWorkspace& workspace, bool& searchedBack);
+        static PathResult bellmanFordSetUps(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                            bool& searchedBack);
         // check weather the input is valid
         static bool isValidInput (const Graph& g, size_t source, size_t dest);
-        // Dijkstra's algorithm for finding the shortest paths in weighted graphs
-        static std::vector<size_t> dijkstra(const Graph& g, size_t source, size_t dest);
+        // Dijkstra's algorithm for finding the shortest paths in weighted graphs, up to dest
+        static size_t dijkstra(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace,
+                               std::vector<size_t>& path);
+
+        // Dijkstra's algorithm from source over the outgoing edges and from dest over the incoming edges
+        static size_t bidirectionalDijkstra(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                            std::vector<size_t>& path, Distance& cost);
+
+        // A* search from source to dest, guided by estimate, a lower bound on the distance of a vertex to dest
+        template <typename Estimate>
+        static size_t aStar(const Graph& g, size_t source, size_t dest, const Estimate& estimate,
+                            QueryWorkspace& workspace, std::vector<size_t>& path);
 
         // Bellman-Ford algorithm for finding the shortest paths, can handle graphs with negative weights
-        static std::vector<size_t> bellmanFord(const Graph& g, size_t source, size_t dest);
+        static void bellmanFord(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace,
+                                std::vector<size_t>& path);
 
         // BFS for finding the shortest paths in unweighted graphs or checking graph connectivity
-        static std::vector<size_t> bfs(const Graph& g, size_t source, size_t dest);
+        static size_t bfs(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace,
+                          std::vector<size_t>& path);
+
+        // BFS without building the path, up to dest or over the whole component of source
+        static size_t bfsSearch(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace);
+
+        // BFS over a bit matrix, expanding 64 candidate neighbors per word operation
+        static size_t bfsBitParallel(const Graph& g, size_t source, size_t dest, QueryWorkspace& workspace);
 
-        // Helper method to construct the shortest path as a string
-        static std::string constructPath(const std::vector<size_t>& path , size_t source,size_t dest);
+        // Helper method to construct the result of a search, no path if path is empty
+        static PathResult constructPath(const Graph& g, const std::vector<size_t>& path, size_t source, size_t dest,
+                                        Distance cost, size_t settled);
 
-        static int CalculatePathCost(std::vector<size_t> &path, const Graph &g);
+        static Distance CalculatePathCost(std::vector<size_t> &path, const Graph &g);
 
-        static std::vector<size_t> buildShortestPath (const Graph& g,  std::vector<int>& dist , size_t source ,size_t dest);
+        static void buildShortestPath (const QueryWorkspace& workspace, size_t source, size_t dest,
+                                       std::vector<size_t>& path);
 
     };
 }
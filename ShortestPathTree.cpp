@@ -0,0 +1,80 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "ShortestPathTree.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ariel {
+
+    const size_t ShortestPathTree::NO_VERTEX;
+
+    /**
+     * A tree of the source alone, every other vertex unreached.
+     */
+    ShortestPathTree::ShortestPathTree(size_t source, size_t numVertices)
+            : root(source), distances(numVertices, std::numeric_limits<Distance>::max()),
+              parents(numVertices, NO_VERTEX) {
+        distances[source] = 0;
+    }
+
+    size_t ShortestPathTree::source() const {
+        return root;
+    }
+
+    // the number of vertices of the graph the tree was built on
+    size_t ShortestPathTree::size() const {
+        return distances.size();
+    }
+
+    /**
+     * @throws std::invalid_argument if v is not a vertex of the graph.
+     */
+    bool ShortestPathTree::reaches(size_t v) const {
+        checkVertex(v);
+        return distances[v] != std::numeric_limits<Distance>::max();
+    }
+
+    /**
+     * @return The length of the shortest path from the source to v, numeric_limits<Distance>::max()
+     *         if the source doesn't reach v.
+     * @throws std::invalid_argument if v is not a vertex of the graph.
+     */
+    Distance ShortestPathTree::distance(size_t v) const {
+        checkVertex(v);
+        return distances[v];
+    }
+
+    /**
+     * @return The vertex before v on its shortest path, NO_VERTEX for the source and unreached vertices.
+     * @throws std::invalid_argument if v is not a vertex of the graph.
+     */
+    size_t ShortestPathTree::parent(size_t v) const {
+        checkVertex(v);
+        return parents[v];
+    }
+
+    /**
+     * Reads the shortest path from the source to dest off the tree, in O(path length).
+     * @return The vertices of the path and its cost, the source alone for dest == source, or NO_PATH.
+     * @throws std::invalid_argument if dest is not a vertex of the graph.
+     */
+    PathResult ShortestPathTree::path(size_t dest) const {
+        checkVertex(dest);
+        // reading the tree searches nothing
+        PathResult result{PathStatus::NO_PATH, root, dest, std::vector<size_t>(), 0, 0};
+        if (distances[dest] == std::numeric_limits<Distance>::max())
+            return result;
+
+        result.status = PathStatus::FOUND;
+        result.cost = distances[dest];
+        for (size_t v = dest; v != NO_VERTEX; v = parents[v])
+            result.vertices.push_back(v);
+        std::reverse(result.vertices.begin(), result.vertices.end());
+        return result;
+    }
+
+    void ShortestPathTree::checkVertex(size_t v) const {
+        if (v >= distances.size())
+            throw std::invalid_argument("Vertex out of range of the shortest path tree");
+    }
+}
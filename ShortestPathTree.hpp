@@ -0,0 +1,48 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef SHORTEST_PATH_TREE_HPP
+#define SHORTEST_PATH_TREE_HPP
+
+#include "AlgorithmResults.hpp"
+#include "GraphProperties.hpp"
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace ariel {
+
+    class ShortestPath;
+
+    /**
+     * The shortest paths from one source to every vertex of a graph, see ShortestPath::FindTree:
+     * the distance and the predecessor of every vertex. Once it is built, the path to any destination
+     * is read back in O(path length) and its distance in O(1).
+     * Vertices are named by their original numbers. The tree is a copy, it stays valid (and describes
+     * the graph as it was) after the graph is changed or destroyed.
+     */
+    class ShortestPathTree {
+    public:
+        static const size_t NO_VERTEX = std::numeric_limits<size_t>::max();
+
+        [[nodiscard]] size_t source() const;
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool reaches(size_t v) const;
+        [[nodiscard]] Distance distance(size_t v) const;
+        [[nodiscard]] size_t parent(size_t v) const;
+        [[nodiscard]] PathResult path(size_t dest) const;
+
+    private:
+        friend class ShortestPath;
+
+        size_t root;
+        // numeric_limits<Distance>::max() for the vertices the source doesn't reach
+        std::vector<Distance> distances;
+        // NO_VERTEX for the source and the vertices it doesn't reach
+        std::vector<size_t> parents;
+
+        explicit ShortestPathTree(size_t source, size_t numVertices);
+        void checkVertex(size_t v) const;
+    };
+}
+
+#endif // SHORTEST_PATH_TREE_HPP
@@ -0,0 +1,146 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "StreamingGraphBuilder.hpp"
+#include "TextParsing.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ariel {
+
+    const size_t StreamingGraphBuilder::DEFAULT_BATCH_BYTES;
+
+    StreamingGraphBuilder::StreamingGraphBuilder() : StreamingGraphBuilder(DEFAULT_BATCH_BYTES) {}
+
+    /**
+     * @param batchBytes The size of the buffer the stream is read into, it only grows for a
+     *                   line that doesn't fit in it.
+     * @throws std::invalid_argument if batchBytes is 0.
+     */
+    StreamingGraphBuilder::StreamingGraphBuilder(size_t batchBytes) : batchBytes(batchBytes) {
+        if (batchBytes == 0) {
+            throw std::invalid_argument("Invalid input: the batch size must be positive.");
+        }
+    }
+
+    /**
+     * Loads the edge lines of the stream, from its current position to its end, into g.
+     * The stream is read twice, so it must support seeking back to where it was.
+     * @throws std::invalid_argument if the stream can't seek, a line can't be read, or an edge appears twice.
+     * @throws std::runtime_error if reading the stream fails.
+     */
+    void StreamingGraphBuilder::build(Graph& g, std::istream& in) const {
+        std::istream::pos_type start = in.tellg();
+        if (start == std::istream::pos_type(-1)) {
+            throw std::invalid_argument("Invalid input: the stream can't be read twice.");
+        }
+        build(g, [this, &in, start](const EdgeSink& sink) {
+            in.clear();
+            in.seekg(start);
+            if (!in) {
+                throw std::invalid_argument("Invalid input: the stream can't be read twice.");
+            }
+            readBatches(in, sink);
+        });
+    }
+
+    /**
+     * Loads the edges emitted by source into g, running source once to count the edges of every
+     * vertex and once more to store them. Besides the graph itself, this takes O(V) memory.
+     * @throws std::invalid_argument if the two runs of source emit different edges, an endpoint is past
+     *         text::MAX_VERTEX_INDEX, or an edge appears twice.
+     */
+    void StreamingGraphBuilder::build(Graph& g, const EdgeSource& source) const {
+        // counting pass: offsets[u + 1] counts the edges of u
+        std::vector<size_t> offsets(1, 0);
+        size_t numEdges = 0;
+        source([&offsets, &numEdges](size_t u, size_t v, Weight weight) {
+            if (weight == 0)
+                return;
+            if (u > text::MAX_VERTEX_INDEX || v > text::MAX_VERTEX_INDEX)
+                throw std::invalid_argument("Invalid input: edge endpoint out of range.");
+            size_t numVertices = std::max(u, v) + 1;
+            if (offsets.size() < numVertices + 1)
+                offsets.resize(numVertices + 1, 0);
+            ++offsets[u + 1];
+            ++numEdges;
+        });
+        size_t numVertices = offsets.size() - 1;
+        for (size_t u = 0; u < numVertices; ++u)
+            offsets[u + 1] += offsets[u];
+
+        // fill pass: next[u] is where the next edge of u goes
+        std::vector<size_t> targets(numEdges);
+        std::vector<Weight> weights(numEdges);
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        auto changed = [] {
+            return std::invalid_argument("Invalid input: the edges changed between the two passes.");
+        };
+        source([&](size_t u, size_t v, Weight weight) {
+            if (weight == 0)
+                return;
+            if (u >= numVertices || v >= numVertices || next[u] == offsets[u + 1])
+                throw changed();
+            size_t pos = next[u]++;
+            targets[pos] = v;
+            weights[pos] = weight;
+        });
+        for (size_t u = 0; u < numVertices; ++u) {
+            if (next[u] != offsets[u + 1])
+                throw changed();
+        }
+        next.clear();
+        next.shrink_to_fit();
+
+        CsrAdjacency built(std::move(offsets), std::move(targets), std::move(weights));
+        built.sortRows();
+        g.loadAdjacency(std::move(built));
+    }
+
+    /**
+     * Reads the stream into a buffer of batchBytes at a time and passes the edges of the whole
+     * lines in it to sink. The start of a line that doesn't end in the buffer is moved to the
+     * front of the buffer for the next batch.
+     */
+    void StreamingGraphBuilder::readBatches(std::istream& in, const EdgeSink& sink) const {
+        std::vector<char> buffer(batchBytes);
+        size_t filled = 0;
+        while (true) {
+            in.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+            filled += static_cast<size_t>(in.gcount());
+            if (in.bad()) {
+                throw std::runtime_error("Cannot read the graph stream.");
+            }
+            bool lastBatch = !in;
+            const char* begin = buffer.data();
+            const char* end = begin + filled;
+            const char* linesEnd = end;
+            if (!lastBatch) {
+                while (linesEnd > begin && linesEnd[-1] != '\n')
+                    --linesEnd;
+                if (linesEnd == begin) {
+                    // a single line fills the whole buffer
+                    buffer.resize(buffer.size() * 2);
+                    continue;
+                }
+            }
+
+            for (const char* line = begin; line < linesEnd; line = text::nextLine(line, linesEnd)) {
+                size_t u = 0;
+                size_t v = 0;
+                Weight weight = 1;
+                if (!text::parseEdgeLine(line, linesEnd, 0, u, v, weight))
+                    continue;
+                if (u > text::MAX_VERTEX_INDEX || v > text::MAX_VERTEX_INDEX)
+                    throw text::lineError(line, linesEnd);
+                sink(u, v, weight);
+            }
+            if (lastBatch)
+                return;
+            filled = static_cast<size_t>(end - linesEnd);
+            std::memmove(buffer.data(), linesEnd, filled);
+        }
+    }
+}
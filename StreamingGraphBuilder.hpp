@@ -0,0 +1,46 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef STREAMING_GRAPH_BUILDER_HPP
+#define STREAMING_GRAPH_BUILDER_HPP
+
+#include "Graph.hpp"
+#include <cstddef>
+#include <functional>
+#include <istream>
+
+/**
+ * Builds a sparse graph from edges that are read twice instead of being kept in memory:
+ * a counting pass takes the out degree of every vertex, then a fill pass writes every edge
+ * straight into its place in the CSR arrays. At no point are the edges held both as a list
+ * and in the graph, so graphs close to the size of the memory can be loaded.
+ * The edges come from a seekable stream of "u v [weight]" lines (vertices numbered from 0,
+ * lines starting with # or % are comments, a missing weight is 1), read in batches of a
+ * fixed number of bytes, or from a function that emits them.
+ * The graph has as many vertices as the largest vertex number plus one.
+ */
+
+namespace ariel {
+    class StreamingGraphBuilder {
+    public:
+        // receives one edge from an EdgeSource, an edge of weight 0 is skipped
+        typedef std::function<void(size_t source, size_t target, Weight weight)> EdgeSink;
+        // emits every edge of the graph into the sink, it is called once per pass and must
+        // emit the same edges both times
+        typedef std::function<void(const EdgeSink& sink)> EdgeSource;
+
+        static const size_t DEFAULT_BATCH_BYTES = size_t(1) << 20;
+
+        StreamingGraphBuilder();
+        explicit StreamingGraphBuilder(size_t batchBytes);
+
+        void build(Graph& g, std::istream& in) const;
+        void build(Graph& g, const EdgeSource& source) const;
+
+    private:
+        size_t batchBytes;
+
+        void readBatches(std::istream& in, const EdgeSink& sink) const;
+    };
+}
+
+#endif // STREAMING_GRAPH_BUILDER_HPP
@@ -0,0 +1,42 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef SUBGRAPH_FILTER_HPP
+#define SUBGRAPH_FILTER_HPP
+
+#include "GraphProperties.hpp"
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace ariel {
+
+    /**
+     * The vertices and edges a subgraph view keeps of the graph it reads, see Graph::loadSubgraphView.
+     * Inside the view, the kept vertices are numbered 0..k-1 in the order of the base graph, so the rows
+     * of the view are sorted; the view maps these numbers to the ones the caller uses like a reordered graph.
+     * Edges are kept when both their endpoints are, and the edge predicate (if any) accepts them.
+     */
+    struct SubgraphFilter {
+        // takes the source, target and weight of an edge
+        typedef std::function<bool(size_t, size_t, Weight)> EdgePredicate;
+
+        static constexpr size_t NO_VERTEX = std::numeric_limits<size_t>::max();
+
+        // the vertex of the base graph behind every vertex of the view
+        std::vector<size_t> baseIds;
+        // the number every vertex of the base graph has in the view, NO_VERTEX if it is left out
+        std::vector<size_t> localIds;
+        // the number every vertex of the view, as the caller numbers it, has in the graph the view was
+        // made of, which is a view itself when views are nested
+        std::vector<size_t> parentIds;
+        // called with vertices of the base graph, empty if every edge between kept vertices is kept
+        EdgePredicate keepEdge;
+
+        bool keeps(size_t from, size_t to, Weight weight) const {
+            return localIds[from] != NO_VERTEX && localIds[to] != NO_VERTEX && (!keepEdge || keepEdge(from, to, weight));
+        }
+    };
+}
+
+#endif // SUBGRAPH_FILTER_HPP
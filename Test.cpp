@@ -4,6 +4,16 @@
 #include "doctest.h"
 #include "Algorithms.hpp"
 #include "Graph.hpp"
+#include "GraphReader.hpp"
+#include "QueryExecutor.hpp"
+#include "QueryWorkspace.hpp"
+#include "StreamingGraphBuilder.hpp"
+#include "VersionedGraph.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
 using namespace std;
 
 
@@ -169,6 +179,12 @@ TEST_CASE("Test shortestPath")
         };
         g.loadGraph(graph19);
         CHECK( ariel::Algorithms::shortestPath(g,3,4)== "Shortest path from 4 to 3 is: 3->1->0->5->4" );
+        // the typed result names the endpoints as they were asked for
+        ariel::PathResult backward = ariel::Algorithms::findShortestPath(g, 3, 4);
+        CHECK(backward.source == 3);
+        CHECK(backward.dest == 4);
+        CHECK(backward.vertices == vector<size_t>{3, 1, 0, 5, 4});
+        CHECK(backward.cost == 18);
 
 
         // Test shortest path with negative weight, negative cycle in the graph,directed, disconnected graph (Bellman-Ford)
@@ -427,6 +443,25 @@ TEST_CASE("Test isContainsCycle")
         g.loadGraph(graph4);
         CHECK(ariel::Algorithms::isContainsCycle(g) == "No cycle found");
     }
+
+    // a directed path of a million vertices is searched without overflowing the call stack
+    {
+        const size_t n = 1000000;
+        vector<pair<size_t, size_t>> edges;
+        for (size_t v = 0; v + 1 < n; ++v)
+            edges.emplace_back(v, v + 1);
+        g.loadEdges(n, edges);
+        CHECK(ariel::Algorithms::isContainsCycle(g) == "No cycle found");
+
+        // closing the path finds the whole of it
+        edges.emplace_back(n - 1, 0);
+        g.loadEdges(n, edges);
+        ariel::CycleResult cycle = ariel::Algorithms::findCycle(g);
+        CHECK(cycle.status == ariel::CycleStatus::FOUND);
+        CHECK(cycle.vertices.size() == n + 1);
+        CHECK(cycle.vertices.front() == 0);
+        CHECK(cycle.vertices.back() == 0);
+    }
 }
 
 TEST_CASE("Test isBipartite")
@@ -514,3 +549,1769 @@ TEST_CASE("Test invalid graph")
 
 
 }
+
+TEST_CASE("Test neighbors")
+{
+    ariel::Graph g;
+    vector<vector<int>> graph = {
+            {0, 4, 0, 7},
+            {0, 0, 0, 0},
+            {1, 0, 0, 2},
+            {0, 3, 0, 0}};
+    g.loadGraph(graph);
+
+    // only the non-zero entries are stored, in increasing vertex order
+    vector<size_t> targets;
+    vector<int> weights;
+    for (ariel::Neighbor edge : g.neighbors(2)) {
+        targets.push_back(edge.vertex);
+        weights.push_back(edge.weight);
+    }
+    CHECK(targets == vector<size_t>{0, 3});
+    CHECK(weights == vector<int>{1, 2});
+    CHECK(g.neighbors(1).empty());
+    CHECK(g.outDegree(0) == 2);
+    CHECK(g.getEdgeWeight(0, 3) == 7);
+    CHECK(g.getEdgeWeight(3, 0) == 0);
+
+    // reversing the graph turns out edges into in edges
+    ariel::Graph reversed = g.getReversedGraph();
+    CHECK(reversed.outDegree(1) == 2);
+    CHECK(reversed.getEdgeWeight(1, 3) == 3);
+    CHECK(reversed.getEdgeWeight(3, 0) == 7);
+    CHECK(reversed.getGraphType() == ariel::GraphType::DIRECTED);
+}
+
+TEST_CASE("Test storage layouts")
+{
+    vector<vector<vector<int>>> graphs = {
+            {{0, 1, 0}, {1, 0, 1}, {0, 1, 0}},
+            {{0, 1, 1, 0, 0}, {1, 0, 1, 0, 0}, {1, 1, 0, 1, 0}, {0, 0, 1, 0, 0}, {0, 0, 0, 0, 0}},
+            {{0, 1, 0, 0, 0}, {0, 0, -5, 0, 0}, {2, 0, 0, 0, 0}, {0, 0, 0, 0, 2}, {0, 0, 0, 0, 0}},
+            {{0, 9, 0, 2, 0}, {9, 0, 3, 0, 0}, {0, 3, 0, 0, 1}, {2, 0, 0, 0, 2}, {0, 0, 1, 2, 0}},
+            {{0, 1, 2, 0, 0}, {1, 0, 5, 0, 1}, {2, 5, 0, 0, 0}, {0, -4, 0, 0, 0}, {0, 1, 0, 2, 0}}};
+
+    // the answer of a shortest path query, or the reason it was rejected
+    auto shortestPathOrError = [](const ariel::Graph& graph, size_t start, size_t end) {
+        try {
+            return ariel::Algorithms::shortestPath(graph, start, end);
+        } catch (const std::exception& e) {
+            return std::string(e.what());
+        }
+    };
+
+    // all layouts must give the same answers
+    for (size_t i = 0; i < graphs.size(); ++i) {
+        const auto& graph = graphs[i];
+        ariel::Graph sparse;
+        ariel::Graph dense;
+        sparse.loadGraph(graph, ariel::StorageLayout::SPARSE);
+        // the first two graphs are unweighted and can be bit packed
+        dense.loadGraph(graph, i < 2 ? ariel::StorageLayout::BITSET : ariel::StorageLayout::DENSE);
+        CHECK(sparse.getStorageLayout() == ariel::StorageLayout::SPARSE);
+        CHECK(dense.getStorageLayout() != ariel::StorageLayout::SPARSE);
+        CHECK(sparse.getGraphType() == dense.getGraphType());
+        CHECK(sparse.getEdgeType() == dense.getEdgeType());
+        CHECK(sparse.getEdgeNegativity() == dense.getEdgeNegativity());
+        CHECK(ariel::Algorithms::isConnected(sparse) == ariel::Algorithms::isConnected(dense));
+        CHECK(ariel::Algorithms::isContainsCycle(sparse) == ariel::Algorithms::isContainsCycle(dense));
+        CHECK(ariel::Algorithms::isBipartite(sparse) == ariel::Algorithms::isBipartite(dense));
+        CHECK(ariel::Algorithms::negativeCycle(sparse) == ariel::Algorithms::negativeCycle(dense));
+        CHECK(shortestPathOrError(sparse, 0, 2) == shortestPathOrError(dense, 0, 2));
+    }
+
+    // the layout is picked by density
+    ariel::Graph g;
+    vector<vector<int>> complete(32, vector<int>(32, 2));
+    for (size_t i = 0; i < complete.size(); ++i)
+        complete[i][i] = 0;
+    g.loadGraph(complete);
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::DENSE);
+    vector<vector<int>> path(100, vector<int>(100, 0));
+    for (size_t i = 0; i + 1 < path.size(); ++i)
+        path[i][i + 1] = 1;
+    g.loadGraph(path);
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::SPARSE);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->1->2->3");
+
+    // reversing and adding a vertex keep the dense layout
+    g.loadGraph(graphs[2], ariel::StorageLayout::DENSE);
+    ariel::Graph reversed = g.getReversedGraph();
+    CHECK(reversed.getStorageLayout() == ariel::StorageLayout::DENSE);
+    CHECK(reversed.getEdgeWeight(2, 1) == -5);
+    ariel::Graph withSource = g.addVertexWithEdges();
+    CHECK(withSource.V() == 6);
+    CHECK(withSource.getEdgeWeight(5, 3) == 10000);
+    CHECK(withSource.getEdgeWeight(3, 4) == 2);
+}
+
+TEST_CASE("Test bit packed layout")
+{
+    // an even cycle spanning several 64 bit words, plus a chord that keeps it bipartite
+    size_t n = 130;
+    vector<vector<int>> cycle(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; ++i) {
+        cycle[i][(i + 1) % n] = 1;
+        cycle[(i + 1) % n][i] = 1;
+    }
+    cycle[0][65] = cycle[65][0] = 1;
+
+    ariel::Graph bits;
+    ariel::Graph sparse;
+    bits.loadGraph(cycle);
+    sparse.loadGraph(cycle, ariel::StorageLayout::SPARSE);
+    CHECK(bits.getStorageLayout() == ariel::StorageLayout::BITSET);
+    CHECK(bits.getEdgeWeight(65, 0) == 1);
+    CHECK(bits.getEdgeWeight(64, 0) == 0);
+    CHECK(ariel::Algorithms::isConnected(bits) == true);
+    CHECK(ariel::Algorithms::shortestPath(bits, 1, 66) == ariel::Algorithms::shortestPath(sparse, 1, 66));
+    CHECK(ariel::Algorithms::shortestPath(bits, 1, 66) == "Shortest path from 1 to 66 is: 1->0->65->66");
+    CHECK(ariel::Algorithms::isBipartite(bits) == ariel::Algorithms::isBipartite(sparse));
+    CHECK(ariel::Algorithms::isContainsCycle(bits) == ariel::Algorithms::isContainsCycle(sparse));
+
+    // an odd chord breaks the bipartition, removing the back edges breaks strong connectivity
+    cycle[0][64] = cycle[64][0] = 1;
+    bits.loadGraph(cycle, ariel::StorageLayout::BITSET);
+    CHECK(ariel::Algorithms::isBipartite(bits) == "Graph is not bipartite");
+    for (size_t i = 0; i < n; ++i)
+        cycle[(i + 1) % n][i] = 0;
+    cycle[0][n - 1] = 0;
+    cycle[n - 1][0] = 1;
+    cycle[1][0] = 0;
+    bits.loadGraph(cycle, ariel::StorageLayout::BITSET);
+    sparse.loadGraph(cycle, ariel::StorageLayout::SPARSE);
+    CHECK(bits.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(ariel::Algorithms::isConnected(bits) == ariel::Algorithms::isConnected(sparse));
+
+    // weighted graphs can't be bit packed
+    vector<vector<int>> weighted = {{0, 2}, {2, 0}};
+    CHECK_THROWS(bits.loadGraph(weighted, ariel::StorageLayout::BITSET));
+}
+
+TEST_CASE("Test loadEdges")
+{
+    ariel::Graph g;
+
+    // undirected unweighted path 0-1-2 given as both directions of every edge
+    g.loadEdges(3, {{0, 1}, {1, 0}, {2, 1}, {1, 2}});
+    CHECK(g.V() == 3);
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::SPARSE);
+    CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+    CHECK(g.getEdgeType() == ariel::EdgeType::UNWEIGHTED);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "Shortest path from 0 to 2 is: 0->1->2");
+
+    // weighted directed graph, edges in any order
+    g.loadEdges(5, {{3, 4}, {1, 2}, {0, 1}, {2, 0}}, {2, -5, 1, 2});
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+    CHECK(g.getEdgeWeight(1, 2) == -5);
+    CHECK(ariel::Algorithms::negativeCycle(g) == "Negative cycle found: 0 -> 1 -> 2 -> 0");
+
+    // the same answers as the equivalent matrix
+    ariel::Graph fromMatrix;
+    fromMatrix.loadGraph({{0, 1, 0, 0, 0}, {0, 0, -5, 0, 0}, {2, 0, 0, 0, 0}, {0, 0, 0, 0, 2}, {0, 0, 0, 0, 0}});
+    CHECK(ariel::Algorithms::isContainsCycle(g) == ariel::Algorithms::isContainsCycle(fromMatrix));
+    CHECK(ariel::Algorithms::shortestPath(g, 3, 4) == ariel::Algorithms::shortestPath(fromMatrix, 3, 4));
+
+    // a million vertices with a handful of edges loads without a V x V matrix
+    g.loadEdges(1000000, {{0, 999999}, {999999, 0}});
+    CHECK(g.V() == 1000000);
+    CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+    CHECK(ariel::Algorithms::isConnected(g) == false);
+
+    // invalid edge lists are rejected and leave the graph untouched
+    CHECK_THROWS(g.loadEdges(3, {{0, 3}}));
+    CHECK_THROWS_AS(g.loadEdges(std::numeric_limits<size_t>::max(), {}), std::invalid_argument);
+    CHECK_THROWS(g.loadEdges(3, {{0, 1}, {0, 1}}));
+    CHECK_THROWS(g.loadEdges(3, {{0, 1}, {1, 2}}, {4}));
+    CHECK(g.V() == 1000000);
+}
+
+TEST_CASE("Test move and view loading")
+{
+    ariel::Graph g;
+
+    // a dense matrix is adopted as is, the caller's vector is emptied
+    vector<vector<int>> dense(40, vector<int>(40, 3));
+    g.loadGraph(std::move(dense));
+    CHECK(dense.empty());
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::DENSE);
+    CHECK(g.getEdgeWeight(0, 39) == 3);
+    CHECK(g.outDegree(39) == 40);
+    CHECK(g.isView() == false);
+
+    // a sparse matrix is converted and the original freed
+    vector<vector<int>> sparse(100, vector<int>(100, 0));
+    sparse[0][1] = sparse[1][0] = 1;
+    g.loadGraph(std::move(sparse));
+    CHECK(sparse.empty());
+    CHECK(g.getStorageLayout() != ariel::StorageLayout::DENSE);
+    CHECK(g.getEdgeWeight(1, 0) == 1);
+
+    // an invalid matrix is left to the caller
+    vector<vector<int>> invalid = {{0, 1}, {1}};
+    CHECK_THROWS(g.loadGraph(std::move(invalid)));
+    CHECK(invalid.size() == 2);
+
+    // a view reads the caller's rows in place
+    vector<vector<int>> graph = {
+            {0, 1, 0},
+            {1, 0, 1},
+            {0, 1, 0}};
+    g.loadGraphView(graph);
+    CHECK(g.isView());
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "Shortest path from 0 to 2 is: 0->1->2");
+    ariel::Graph copy = g;
+    CHECK(copy.isView());
+    CHECK(ariel::Algorithms::isBipartite(copy) == "Graph is bipartite, A={0,2}, B={1}");
+
+    // a view of a flat padded buffer
+    vector<int> cells = {
+            0, 2, 9, -1,
+            0, 0, 2, -1,
+            0, 0, 0, -1};
+    g.loadGraphView(cells.data(), 3, 4);
+    CHECK(g.isView());
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "Shortest path from 0 to 2 is: 0->1->2");
+    CHECK_THROWS(g.loadGraphView(cells.data(), 3, 2));
+
+    // the reversed graph is an owned copy
+    ariel::Graph reversed = g.getReversedGraph();
+    CHECK(reversed.isView() == false);
+    CHECK(reversed.getEdgeWeight(2, 0) == 9);
+}
+
+TEST_CASE("Test load classification")
+{
+    // compare the single pass classification with a naive one on sizes around the 4x4 blocks and 64x64 tiles
+    std::srand(7);
+    ariel::Graph g;
+    for (size_t n : {1u, 2u, 3u, 4u, 5u, 7u, 8u, 9u, 63u, 64u, 65u, 70u}) {
+        for (int variant = 0; variant < 4; ++variant) {
+            vector<vector<int>> matrix(n, vector<int>(n, 0));
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = i; j < n; ++j) {
+                    int weight = std::rand() % 3 == 0 ? 1 : 0;
+                    if (variant >= 2 && weight != 0)
+                        weight = std::rand() % 7 - 2;
+                    matrix[i][j] = matrix[j][i] = weight;
+                }
+            }
+            // odd variants break the symmetry in a single random cell
+            if (variant % 2 == 1) {
+                size_t i = static_cast<size_t>(std::rand()) % n;
+                size_t j = static_cast<size_t>(std::rand()) % n;
+                matrix[i][j] += (i == j) ? 0 : 5;
+            }
+
+            size_t edges = 0;
+            bool weighted = false;
+            bool negative = false;
+            bool symmetric = true;
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t j = 0; j < n; ++j) {
+                    edges += matrix[i][j] != 0 ? 1u : 0u;
+                    weighted = weighted || (matrix[i][j] != 0 && matrix[i][j] != 1);
+                    negative = negative || matrix[i][j] < 0;
+                    symmetric = symmetric && matrix[i][j] == matrix[j][i];
+                }
+            }
+
+            g.loadGraph(matrix);
+            CHECK(g.E() == edges);
+            CHECK((g.getEdgeType() == ariel::EdgeType::WEIGHTED) == weighted);
+            CHECK((g.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE) == negative);
+            CHECK((g.getGraphType() == ariel::GraphType::UNDIRECTED) == symmetric);
+        }
+    }
+}
+
+TEST_CASE("Test incoming edges")
+{
+    // a directed cycle 0->1->...->69->0 with a chord out of every vertex
+    const size_t n = 70;
+    vector<vector<int>> graph(n, vector<int>(n, 0));
+    for (size_t i = 0; i < n; ++i) {
+        graph[i][(i + 1) % n] = 1;
+        graph[i][(i * 7 + 3) % n] = 1;
+    }
+
+    ariel::Graph g;
+    for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                        ariel::StorageLayout::BITSET}) {
+        g.loadGraph(graph, layout);
+        for (size_t v = 0; v < n; ++v) {
+            vector<size_t> sources;
+            for (ariel::Neighbor edge : g.inNeighbors(v)) {
+                CHECK(edge.weight == g.getEdgeWeight(edge.vertex, v));
+                sources.push_back(edge.vertex);
+            }
+            vector<size_t> expected;
+            for (size_t u = 0; u < n; ++u) {
+                if (graph[u][v] != 0)
+                    expected.push_back(u);
+            }
+            CHECK(sources == expected);
+            CHECK(g.inDegree(v) == expected.size());
+        }
+        CHECK(ariel::Algorithms::isConnected(g) == true);
+    }
+
+    // the columns of views read the same edges, from nested rows and from a flat buffer with padded rows
+    {
+        ariel::Graph owned;
+        owned.loadGraph(graph, ariel::StorageLayout::DENSE);
+        const size_t stride = n + 5;
+        vector<int> cells(n * stride, 7);
+        for (size_t u = 0; u < n; ++u)
+            std::copy(graph[u].begin(), graph[u].end(), cells.begin() + static_cast<std::ptrdiff_t>(u * stride));
+        ariel::Graph nestedView;
+        nestedView.loadGraphView(graph);
+        ariel::Graph flatView;
+        flatView.loadGraphView(cells.data(), n, stride);
+        for (size_t v = 0; v < n; ++v) {
+            vector<size_t> expected, nested, flat;
+            for (ariel::Neighbor edge : owned.inNeighbors(v))
+                expected.push_back(edge.vertex);
+            for (ariel::Neighbor edge : nestedView.inNeighbors(v))
+                nested.push_back(edge.vertex);
+            for (ariel::Neighbor edge : flatView.inNeighbors(v))
+                flat.push_back(edge.vertex);
+            CHECK(nested == expected);
+            CHECK(flat == expected);
+        }
+    }
+
+    // without any edge into vertex 69 it can't be reached from vertex 0
+    graph[68][69] = 0;
+    for (size_t i = 0; i < n; ++i)
+        graph[i][69] = 0;
+    for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                        ariel::StorageLayout::BITSET}) {
+        g.loadGraph(graph, layout);
+        CHECK(g.inNeighbors(69).empty());
+        CHECK(ariel::Algorithms::isConnected(g) == false);
+    }
+
+    // a copy taken before a reload keeps walking its own edges
+    g.loadGraph({{0, 2, 0}, {0, 0, 3}, {4, 0, 0}}, ariel::StorageLayout::SPARSE);
+    ariel::Graph copy = g;
+    CHECK((*copy.inNeighbors(0).begin()).vertex == 2);
+    g.loadGraph({{0, 0, 0}, {5, 0, 0}, {0, 0, 0}}, ariel::StorageLayout::SPARSE);
+    CHECK((*g.inNeighbors(0).begin()).vertex == 1);
+    CHECK((*copy.inNeighbors(0).begin()).weight == 4);
+}
+
+TEST_CASE("Test negative cycle virtual source")
+{
+    ariel::Graph g;
+
+    // running on the graph with the source vertex built explicitly finds the same cycles
+    vector<vector<vector<int>>> graphs = {
+            {{0, 1, 0, 0, 0}, {0, 0, -5, 0, 0}, {2, 0, 0, 0, 0}, {0, 0, 0, 0, 2}, {0, 0, 0, 0, 0}},
+            {{0, 1, -2, 4}, {1, 0, -1, 0}, {0, -1, 0, 0}, {0, 0, 2, 0}},
+            {{0, 1, 0, 4}, {1, 0, -1, 0}, {-2, 0, 0, 0}, {0, 0, 2, 0}},
+            {{0, -1, 0}, {0, 0, -1}, {0, 0, 0}}
+    };
+    for (const auto& graph : graphs) {
+        g.loadGraph(graph);
+        CHECK(ariel::Algorithms::negativeCycle(g) == ariel::Algorithms::negativeCycle(g.addVertexWithEdges()));
+    }
+
+    // a long directed path whose last three vertices close a negative cycle, unreachable from vertex 0 backwards
+    const size_t n = 2000;
+    vector<pair<size_t, size_t>> edges;
+    vector<int> weights;
+    for (size_t i = 0; i + 1 < n; ++i) {
+        edges.emplace_back(i, i + 1);
+        weights.push_back(3);
+    }
+    edges.emplace_back(n - 1, n - 3);
+    weights.push_back(-7);
+    g.loadEdges(n, edges, weights);
+    CHECK(ariel::Algorithms::negativeCycle(g) == "Negative cycle found: 1997 -> 1998 -> 1999 -> 1997");
+
+    weights.back() = -5;
+    g.loadEdges(n, edges, weights);
+    CHECK(ariel::Algorithms::negativeCycle(g) == "No negative cycle detected in the graph");
+}
+
+TEST_CASE("Test graph mutation")
+{
+    // apply random updates to graphs in every layout and compare with loading the updated matrix
+    std::srand(11);
+    for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                        ariel::StorageLayout::BITSET, ariel::StorageLayout::DYNAMIC}) {
+        const size_t n = 12;
+        vector<vector<int>> matrix(n, vector<int>(n, 0));
+        for (size_t i = 0; i + 1 < n; ++i)
+            matrix[i][i + 1] = matrix[i + 1][i] = 1;
+
+        ariel::Graph g;
+        g.loadGraph(matrix, layout);
+        for (int step = 0; step < 300; ++step) {
+            size_t u = static_cast<size_t>(std::rand()) % n;
+            size_t v = static_cast<size_t>(std::rand()) % n;
+            // mostly unit weights, so the bit matrix is kept for a while
+            int weight = std::rand() % 10 == 0 ? std::rand() % 9 - 4 : std::rand() % 2;
+            g.setWeight(u, v, weight);
+            matrix[u][v] = weight;
+            // keep the graph symmetric every other step, so both graph types show up
+            if (step % 2 == 0) {
+                g.setWeight(v, u, weight);
+                matrix[v][u] = weight;
+            }
+
+            ariel::Graph expected;
+            expected.loadGraph(matrix);
+            CHECK(g.E() == expected.E());
+            CHECK(g.getGraphType() == expected.getGraphType());
+            CHECK(g.getEdgeType() == expected.getEdgeType());
+            CHECK(g.getEdgeNegativity() == expected.getEdgeNegativity());
+        }
+        for (size_t u = 0; u < n; ++u) {
+            for (size_t v = 0; v < n; ++v)
+                CHECK(g.getEdgeWeight(u, v) == matrix[u][v]);
+            CHECK(g.inDegree(u) == static_cast<size_t>(std::count_if(
+                    matrix.begin(), matrix.end(), [u](const vector<int>& row) { return row[u] != 0; })));
+        }
+    }
+
+    // a matrix loaded straight into per-vertex edge vectors
+    ariel::Graph g;
+    g.loadGraph({{0, 2, 0}, {0, 0, 3}, {1, 0, 0}}, ariel::StorageLayout::DYNAMIC);
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::DYNAMIC);
+    CHECK(g.E() == 3);
+    CHECK(g.getEdgeWeight(1, 2) == 3);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "Shortest path from 0 to 2 is: 0->1->2");
+
+    // add and remove edges and vertices of a sparse graph
+    g.loadEdges(3, {{0, 1}, {1, 0}});
+    CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+    g.addEdge(1, 2);
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::DYNAMIC);
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(ariel::Algorithms::isConnected(g) == false);
+    g.addEdge(2, 0, 4);
+    CHECK(g.getEdgeType() == ariel::EdgeType::WEIGHTED);
+    CHECK(ariel::Algorithms::isConnected(g) == true);
+    CHECK(ariel::Algorithms::shortestPath(g, 2, 1) == "Shortest path from 2 to 1 is: 2->0->1");
+    CHECK_THROWS(g.addEdge(2, 0, 1));
+    CHECK_THROWS(g.addEdge(0, 2, 0));
+    CHECK_THROWS(g.removeEdge(0, 2));
+    CHECK_THROWS(g.setWeight(0, 3, 1));
+
+    CHECK(g.addVertex() == 3);
+    CHECK(g.V() == 4);
+    CHECK(ariel::Algorithms::isConnected(g) == false);
+    g.addEdge(3, 0, -1);
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+    g.removeEdge(3, 0);
+    g.removeEdge(2, 0);
+    g.removeEdge(1, 2);
+    CHECK(g.E() == 2);
+    CHECK(g.getEdgeType() == ariel::EdgeType::UNWEIGHTED);
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NONE);
+    CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+
+    // modifying a view copies it, the caller's matrix is never written
+    vector<vector<int>> shared = {{0, 1}, {1, 0}};
+    g.loadGraphView(shared);
+    g.removeEdge(0, 1);
+    CHECK(shared[0][1] == 1);
+    CHECK(g.isView() == false);
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(g.addVertex() == 2);
+    CHECK(g.getEdgeWeight(1, 0) == 1);
+}
+
+TEST_CASE("Test wide distances")
+{
+    // the path 0->1->2 costs more than the largest int, the direct edge 0->2 is shorter
+    ariel::Graph g;
+    const int heavy = 2000000000;
+    g.loadEdges(3, {{0, 1}, {1, 2}, {0, 2}}, {heavy, heavy, std::numeric_limits<int>::max()});
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2) == "Shortest path from 0 to 2 is: 0->2");
+
+    // same with a negative edge, through bellman-ford
+    g.loadEdges(4, {{0, 1}, {1, 2}, {0, 2}, {2, 3}}, {heavy, heavy, std::numeric_limits<int>::max(), -1});
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->2->3");
+    CHECK(sizeof(ariel::Distance) >= 8);
+}
+
+TEST_CASE("Test vertex reordering")
+{
+    // an undirected path over randomly numbered vertices, plus an odd cycle 40-41-42 on the side
+    const size_t n = 43;
+    vector<size_t> labels(40);
+    for (size_t i = 0; i < labels.size(); ++i)
+        labels[i] = i;
+    std::srand(5);
+    for (size_t i = labels.size() - 1; i > 0; --i)
+        std::swap(labels[i], labels[static_cast<size_t>(std::rand()) % (i + 1)]);
+    vector<vector<int>> graph(n, vector<int>(n, 0));
+    for (size_t i = 0; i + 1 < labels.size(); ++i)
+        graph[labels[i]][labels[i + 1]] = graph[labels[i + 1]][labels[i]] = static_cast<int>(i % 3) + 1;
+    graph[40][41] = graph[41][40] = graph[41][42] = graph[42][41] = graph[42][40] = graph[40][42] = 1;
+
+    ariel::Graph g;
+    g.loadGraph(graph);
+    ariel::Graph bipartite;
+    vector<vector<int>> pathOnly(40);
+    for (size_t i = 0; i < pathOnly.size(); ++i)
+        pathOnly[i].assign(graph[i].begin(), graph[i].begin() + 40);
+    bipartite.loadGraph(pathOnly);
+    size_t first = labels.front();
+    size_t last = labels.back();
+    std::string path = ariel::Algorithms::shortestPath(g, first, last);
+    std::string noPath = ariel::Algorithms::shortestPath(g, first, 41);
+    std::string cycle = ariel::Algorithms::isContainsCycle(g);
+
+    for (ariel::VertexOrder order : {ariel::VertexOrder::DEGREE, ariel::VertexOrder::BFS,
+                                     ariel::VertexOrder::REVERSE_CUTHILL_MCKEE}) {
+        ariel::Graph reordered = g;
+        reordered.reorder(order);
+        CHECK(reordered.isReordered());
+        CHECK(reordered.E() == g.E());
+        for (size_t v = 0; v < n; ++v) {
+            CHECK(reordered.originalId(reordered.internalId(v)) == v);
+            CHECK(reordered.outDegree(reordered.internalId(v)) == g.outDegree(v));
+        }
+        CHECK(ariel::Algorithms::shortestPath(reordered, first, last) == path);
+        CHECK(ariel::Algorithms::shortestPath(reordered, first, 41) == noPath);
+        CHECK(ariel::Algorithms::isConnected(reordered) == false);
+        // the only cycle goes through 40, 41 and 42
+        std::string found = ariel::Algorithms::isContainsCycle(reordered);
+        CHECK(found.size() == cycle.size());
+        CHECK(found.find("40") != std::string::npos);
+
+        ariel::Graph reorderedBipartite = bipartite;
+        reorderedBipartite.reorder(order);
+        CHECK(ariel::Algorithms::isBipartite(reorderedBipartite) == ariel::Algorithms::isBipartite(bipartite));
+
+        reordered.reorder(ariel::VertexOrder::ORIGINAL);
+        CHECK(reordered.isReordered() == false);
+        for (size_t u = 0; u < n; ++u) {
+            for (size_t v = 0; v < n; ++v)
+                CHECK(reordered.getEdgeWeight(u, v) == graph[u][v]);
+        }
+    }
+
+    // reverse Cuthill-McKee lays the path along the diagonal
+    ariel::Graph rcm = bipartite;
+    rcm.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+    size_t bandwidth = 0;
+    for (size_t u = 0; u < rcm.V(); ++u) {
+        for (ariel::Neighbor edge : rcm.neighbors(u))
+            bandwidth = std::max(bandwidth, edge.vertex > u ? edge.vertex - u : u - edge.vertex);
+    }
+    CHECK(bandwidth == 1);
+
+    // the bit matrix and the dense matrix are renumbered in place of the sparse one
+    ariel::Graph bits;
+    bits.loadGraph({{0, 1, 1}, {1, 0, 0}, {1, 0, 0}}, ariel::StorageLayout::BITSET);
+    bits.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+    CHECK(bits.getStorageLayout() == ariel::StorageLayout::BITSET);
+    CHECK(ariel::Algorithms::isBipartite(bits) == "Graph is bipartite, A={0}, B={1,2}");
+    CHECK(ariel::Algorithms::shortestPath(bits, 1, 2) == "Shortest path from 1 to 2 is: 1->0->2");
+    CHECK(bits.addVertex() == 3);
+    CHECK(bits.originalId(3) == 3);
+
+    // the reversed graph and the graph with an added vertex keep the numbers of a reordered graph
+    vector<vector<int>> directed = {
+            {0, 4, 0, 0, 1},
+            {0, 0, 2, 0, 0},
+            {0, 0, 0, 1, 0},
+            {3, 0, 0, 0, 0},
+            {0, 0, 0, 6, 0}};
+    ariel::Graph plain;
+    plain.loadGraph(directed);
+    ariel::Graph reversedPlain = plain.getReversedGraph();
+    ariel::Graph withSourcePlain = plain.addVertexWithEdges();
+    for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                        ariel::StorageLayout::DYNAMIC}) {
+        ariel::Graph reordered;
+        reordered.loadGraph(directed, layout);
+        reordered.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+        CHECK(reordered.isReordered());
+
+        ariel::Graph reversed = reordered.getReversedGraph();
+        CHECK(reversed.isReordered());
+        for (size_t u = 0; u < directed.size(); ++u) {
+            for (size_t v = 0; v < directed.size(); ++v)
+                CHECK(reversed.getEdgeWeight(reversed.internalId(v), reversed.internalId(u)) == directed[u][v]);
+        }
+        CHECK(ariel::Algorithms::shortestPath(reversed, 0, 3) == ariel::Algorithms::shortestPath(reversedPlain, 0, 3));
+        CHECK(ariel::Algorithms::shortestPath(reversed, 0, 3) == "Shortest path from 0 to 3 is: 0->3");
+
+        ariel::Graph withSource = reordered.addVertexWithEdges();
+        CHECK(withSource.V() == 6);
+        CHECK(withSource.originalId(5) == 5);
+        CHECK(withSource.internalId(5) == 5);
+        for (size_t v = 0; v < directed.size(); ++v) {
+            CHECK(withSource.getEdgeWeight(5, withSource.internalId(v)) == 10000);
+            CHECK(withSource.originalId(withSource.internalId(v)) == v);
+        }
+        CHECK(ariel::Algorithms::shortestPath(withSource, 0, 2) == ariel::Algorithms::shortestPath(withSourcePlain, 0, 2));
+    }
+}
+
+TEST_CASE("Test compressed storage")
+{
+    // a weighted directed graph with negative and wide weights, an edge to itself and a vertex with no edges
+    vector<vector<int>> weighted = {
+            {0, 3, 0, 0, 200000, 0},
+            {0, 1, -2, 0, 0, 0},
+            {0, 0, 0, 4, 0, 0},
+            {5, 0, 0, 0, 0, 70},
+            {0, 0, 0, 0, 0, 0},
+            {0, 0, 0, 0, 1, 0}};
+    ariel::Graph sparse;
+    sparse.loadGraph(weighted, ariel::StorageLayout::SPARSE);
+    ariel::Graph packed;
+    packed.loadGraph(weighted, ariel::StorageLayout::COMPRESSED);
+    CHECK(packed.getStorageLayout() == ariel::StorageLayout::COMPRESSED);
+    CHECK(packed.E() == sparse.E());
+    CHECK(packed.getGraphType() == sparse.getGraphType());
+    CHECK(packed.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+    for (size_t u = 0; u < weighted.size(); ++u) {
+        CHECK(packed.outDegree(u) == sparse.outDegree(u));
+        CHECK(packed.inDegree(u) == sparse.inDegree(u));
+        for (size_t v = 0; v < weighted.size(); ++v)
+            CHECK(packed.getEdgeWeight(u, v) == weighted[u][v]);
+        vector<size_t> expected;
+        for (ariel::Neighbor edge : sparse.neighbors(u))
+            expected.push_back(edge.vertex);
+        vector<size_t> decoded;
+        for (ariel::Neighbor edge : packed.neighbors(u))
+            decoded.push_back(edge.vertex);
+        CHECK(decoded == expected);
+    }
+    CHECK(ariel::Algorithms::shortestPath(packed, 0, 5) == ariel::Algorithms::shortestPath(sparse, 0, 5));
+    CHECK(ariel::Algorithms::isContainsCycle(packed) == ariel::Algorithms::isContainsCycle(sparse));
+    CHECK(ariel::Algorithms::isConnected(packed) == ariel::Algorithms::isConnected(sparse));
+    CHECK(ariel::Algorithms::negativeCycle(packed) == ariel::Algorithms::negativeCycle(sparse));
+    ariel::Graph reversed = packed.getReversedGraph();
+    CHECK(reversed.getStorageLayout() == ariel::StorageLayout::COMPRESSED);
+    CHECK(reversed.getEdgeWeight(4, 0) == 200000);
+
+    // an unweighted ring: unit weights are not stored, so every edge takes a byte or two
+    const size_t n = 1000;
+    vector<pair<size_t, size_t>> ring;
+    for (size_t i = 0; i < n; ++i) {
+        ring.emplace_back(i, (i + 1) % n);
+        ring.emplace_back((i + 1) % n, i);
+    }
+    ariel::Graph g;
+    g.loadEdges(n, ring);
+    std::string path = ariel::Algorithms::shortestPath(g, 0, 300);
+    std::string bipartite = ariel::Algorithms::isBipartite(g);
+    g.compress();
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::COMPRESSED);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 300) == path);
+    CHECK(ariel::Algorithms::isBipartite(g) == bipartite);
+    CHECK(ariel::Algorithms::isConnected(g) == true);
+
+    ariel::CompressedAdjacency encoded(true);
+    for (size_t u = 0; u < n; ++u)
+        encoded.appendRow(g.neighbors(u));
+    CHECK(encoded.E() == 2 * n);
+    CHECK(encoded.byteSize() < n * sizeof(size_t) + 2 * n * (sizeof(size_t) + sizeof(ariel::Weight)) / 3);
+
+    // reordering keeps the layout, modifying the graph moves it to edge vectors
+    g.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::COMPRESSED);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 300) == path);
+    g.removeEdge(g.internalId(0), g.internalId(1));
+    CHECK(g.getStorageLayout() == ariel::StorageLayout::DYNAMIC);
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(g.addVertex() == n);
+}
+
+TEST_CASE("Test mapped graph files")
+{
+    vector<vector<int>> graph = {
+            {0, 4, 0, 0, 1},
+            {0, 0, 2, 0, 0},
+            {0, 0, 0, -1, 0},
+            {3, 0, 0, 0, 0},
+            {0, 0, 0, 6, 0}};
+    const char* path = "graph_file_test.bin";
+    ariel::Graph g;
+    g.loadGraph(graph, ariel::StorageLayout::DENSE);
+    g.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+    g.save(path);
+
+    ariel::Graph copy;
+    {
+        ariel::Graph mapped;
+        mapped.openMapped(path);
+        CHECK(mapped.isMapped());
+        CHECK(mapped.getStorageLayout() == ariel::StorageLayout::SPARSE);
+        CHECK(mapped.V() == 5);
+        CHECK(mapped.E() == 6);
+        CHECK(mapped.getGraphType() == ariel::GraphType::DIRECTED);
+        CHECK(mapped.getEdgeType() == ariel::EdgeType::WEIGHTED);
+        CHECK(mapped.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+        CHECK(mapped.isReordered());
+        for (size_t u = 0; u < graph.size(); ++u) {
+            for (size_t v = 0; v < graph.size(); ++v)
+                CHECK(mapped.getEdgeWeight(mapped.internalId(u), mapped.internalId(v)) == graph[u][v]);
+        }
+        CHECK(ariel::Algorithms::shortestPath(mapped, 0, 3) == "Shortest path from 0 to 3 is: 0->1->2->3");
+        copy = mapped;
+    }
+    // the copy keeps the file mapped after the graph it was copied from is gone
+    CHECK(copy.isMapped());
+    CHECK(ariel::Algorithms::isConnected(copy) == true);
+    CHECK(ariel::Algorithms::isContainsCycle(copy) == ariel::Algorithms::isContainsCycle(g));
+
+    // modifying the graph copies the edges out of the file, which is left as it was
+    copy.removeEdge(copy.internalId(2), copy.internalId(3));
+    CHECK(copy.isMapped() == false);
+    CHECK(ariel::Algorithms::shortestPath(copy, 0, 3) == "Shortest path from 0 to 3 is: 0->4->3");
+    ariel::Graph reopened;
+    reopened.openMapped(path);
+    CHECK(reopened.getEdgeWeight(reopened.internalId(2), reopened.internalId(3)) == -1);
+
+    // unweighted, undirected and not reordered
+    ariel::Graph ring;
+    ring.loadEdges(4, {{0, 1}, {1, 0}, {1, 2}, {2, 1}, {2, 3}, {3, 2}, {3, 0}, {0, 3}});
+    ring.save(path);
+    reopened.openMapped(path);
+    CHECK(reopened.isReordered() == false);
+    CHECK(reopened.getGraphType() == ariel::GraphType::UNDIRECTED);
+    CHECK(reopened.getEdgeType() == ariel::EdgeType::UNWEIGHTED);
+    CHECK(ariel::Algorithms::isBipartite(reopened) == "Graph is bipartite, A={0,2}, B={1,3}");
+
+    // the vertex ids of a reordered graph end the file, and must be a permutation of its vertices
+    const char* corruptPath = "graph_file_corrupt_test.bin";
+    for (size_t corruptId : {size_t(5), size_t(-1), g.originalId(0)}) {
+        g.save(corruptPath);
+        {
+            std::fstream file(corruptPath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(-static_cast<std::streamoff>(sizeof(size_t)), std::ios::end);
+            file.write(reinterpret_cast<const char*>(&corruptId), sizeof(size_t));
+        }
+        CHECK_THROWS_AS(reopened.openMapped(corruptPath), std::invalid_argument);
+        // the graph is left as it was
+        CHECK(reopened.V() == 4);
+        CHECK(ariel::Algorithms::isBipartite(reopened) == "Graph is bipartite, A={0,2}, B={1,3}");
+    }
+
+    // so must the rows: offsets that go back, and a target that is not a vertex
+    const std::streamoff offsetsStart = 48;
+    const std::streamoff targetsStart = offsetsStart + static_cast<std::streamoff>((g.V() + 1) * sizeof(size_t));
+    for (std::pair<std::streamoff, size_t> corruption : {std::make_pair(offsetsStart + 8, size_t(-1)),
+                                                        std::make_pair(targetsStart, g.V())}) {
+        g.save(corruptPath);
+        {
+            std::fstream file(corruptPath, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(corruption.first);
+            file.write(reinterpret_cast<const char*>(&corruption.second), sizeof(size_t));
+        }
+        CHECK_THROWS_AS(reopened.openMapped(corruptPath), std::invalid_argument);
+        CHECK(reopened.V() == 4);
+    }
+    std::remove(corruptPath);
+
+    {
+        std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+        truncated << "ARIELGRF";
+    }
+    CHECK_THROWS_AS(reopened.openMapped(path), std::invalid_argument);
+    std::remove(path);
+    CHECK_THROWS_AS(reopened.openMapped(path), std::runtime_error);
+}
+
+TEST_CASE("Test text graph files")
+{
+    const char* path = "graph_text_test.txt";
+    ariel::Graph g;
+    {
+        std::ofstream file(path);
+        file << "# source target weight\n0 1 4\n1 2\n\n2 0 -3\r\n  % a comment\n3 3 2\n";
+    }
+    ariel::GraphReader::readEdgeList(g, path);
+    CHECK(g.V() == 4);
+    CHECK(g.E() == 4);
+    CHECK(g.getEdgeWeight(0, 1) == 4);
+    CHECK(g.getEdgeWeight(1, 2) == 1);
+    CHECK(g.getEdgeWeight(2, 0) == -3);
+    CHECK(g.getEdgeWeight(3, 3) == 2);
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+
+    {
+        std::ofstream file(path);
+        file << "c a DIMACS graph\np sp 4 3\nc arcs\na 1 2 7\na 2 3 1\na 4 1 2\n";
+    }
+    ariel::GraphReader::readDimacs(g, path);
+    CHECK(g.V() == 4);
+    CHECK(g.E() == 3);
+    CHECK(ariel::Algorithms::shortestPath(g, 3, 2) == "Shortest path from 3 to 2 is: 3->0->1->2");
+
+    {
+        std::ofstream file(path);
+        file << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 3\n2 1 1.0\n3 2 2.5e0\n3 3 -1\n";
+    }
+    CHECK_THROWS_AS(ariel::GraphReader::readMatrixMarket(g, path), std::invalid_argument);
+    {
+        std::ofstream file(path);
+        file << "%%MatrixMarket matrix coordinate real symmetric\n% comment\n3 3 3\n2 1 1.0\n3 2 2.0e0\n3 3 -1\n";
+    }
+    ariel::GraphReader::readMatrixMarket(g, path);
+    CHECK(g.V() == 3);
+    CHECK(g.E() == 5);
+    CHECK(g.getEdgeWeight(0, 1) == 1);
+    CHECK(g.getEdgeWeight(1, 0) == 1);
+    CHECK(g.getEdgeWeight(1, 2) == 2);
+    CHECK(g.getEdgeWeight(2, 2) == -1);
+    CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+
+    {
+        std::ofstream file(path);
+        file << "%%MatrixMarket matrix coordinate pattern general\n2 2 1\n1 2\n";
+    }
+    ariel::GraphReader::readMatrixMarket(g, path);
+    CHECK(g.getEdgeWeight(0, 1) == 1);
+    CHECK(g.getEdgeType() == ariel::EdgeType::UNWEIGHTED);
+
+    // bad input
+    {
+        std::ofstream file(path);
+        file << "0 1 2\n1 x 3\n";
+    }
+    CHECK_THROWS_AS(ariel::GraphReader::readEdgeList(g, path), std::invalid_argument);
+    {
+        std::ofstream file(path);
+        file << "p sp 2 1\na 1 3 1\n";
+    }
+    CHECK_THROWS_AS(ariel::GraphReader::readDimacs(g, path), std::invalid_argument);
+    {
+        std::ofstream file(path);
+        file << "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n";
+    }
+    CHECK_THROWS_AS(ariel::GraphReader::readMatrixMarket(g, path), std::invalid_argument);
+
+    // numbers that don't fit a vertex index or a weight are rejected, not wrapped around
+    {
+        std::ofstream file(path);
+        file << "0 18446744073709551617 1\n";
+    }
+    CHECK_THROWS_AS(ariel::GraphReader::readEdgeList(g, path), std::invalid_argument);
+    // an index that fits a size_t but leaves no room for the vertex count
+    for (const char* line : {"18446744073709551614 0\n", "0 18446744073709551615\n"}) {
+        {
+            std::ofstream file(path);
+            file << line;
+        }
+        CHECK_THROWS_AS(ariel::GraphReader::readEdgeList(g, path), std::invalid_argument);
+    }
+    if (std::is_integral<ariel::Weight>::value) {
+        unsigned long long largest = static_cast<unsigned long long>(std::numeric_limits<ariel::Weight>::max());
+        long long lowest = static_cast<long long>(std::numeric_limits<ariel::Weight>::min());
+        {
+            std::ofstream file(path);
+            file << "0 1 " << largest << "\n1 0 " << lowest << "\n";
+        }
+        ariel::GraphReader::readEdgeList(g, path);
+        CHECK(g.getEdgeWeight(0, 1) == std::numeric_limits<ariel::Weight>::max());
+        CHECK(g.getEdgeWeight(1, 0) == std::numeric_limits<ariel::Weight>::min());
+        for (const std::string& weight : {std::to_string(largest + 1), std::to_string(lowest - 1),
+                                          std::string("1234567890123456789012345"), std::string("1e30")}) {
+            {
+                std::ofstream file(path);
+                file << "0 1 " << weight << "\n";
+            }
+            CHECK_THROWS_AS(ariel::GraphReader::readEdgeList(g, path), std::invalid_argument);
+        }
+    }
+
+    // a file big enough to be parsed by several threads, the edges come back in the same graph
+    const size_t n = 200000;
+    {
+        std::ofstream file(path);
+        for (size_t i = 0; i < n; ++i)
+            file << i << ' ' << (i + 1) % n << ' ' << i % 7 + 1 << '\n';
+    }
+    ariel::GraphReader::readEdgeList(g, path);
+    CHECK(g.V() == n);
+    CHECK(g.E() == n);
+    bool allEdges = true;
+    for (size_t i = 0; i < n; ++i)
+        allEdges = allEdges && g.getEdgeWeight(i, (i + 1) % n) == static_cast<int>(i % 7 + 1);
+    CHECK(allEdges);
+    std::remove(path);
+    CHECK_THROWS_AS(ariel::GraphReader::readEdgeList(g, path), std::runtime_error);
+}
+
+TEST_CASE("Test streaming graph builder")
+{
+    // a small batch, so lines are cut between batches and the long comment has to grow the buffer
+    ariel::StreamingGraphBuilder builder(16);
+    std::stringstream in;
+    in << "# a comment longer than a whole batch of the builder\n0 1 5\n1 2\n2 0 -1\n\n3 1 2\n1 0 5\n4 4 0\n2 3";
+    ariel::Graph g;
+    builder.build(g, in);
+    CHECK(g.V() == 4);
+    CHECK(g.E() == 6);
+    CHECK(g.getEdgeWeight(0, 1) == 5);
+    CHECK(g.getEdgeWeight(1, 0) == 5);
+    CHECK(g.getEdgeWeight(1, 2) == 1);
+    CHECK(g.getEdgeWeight(2, 3) == 1);
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+
+    // the same graph as loadEdges builds from the edge list
+    const size_t side = 50;
+    vector<pair<size_t, size_t>> edges;
+    vector<int> weights;
+    auto grid = [side](const ariel::StreamingGraphBuilder::EdgeSink& sink) {
+        for (size_t r = 0; r < side; ++r) {
+            for (size_t c = 0; c < side; ++c) {
+                size_t v = r * side + c;
+                if (c + 1 < side) {
+                    sink(v + 1, v, static_cast<int>(r + 1));
+                    sink(v, v + 1, static_cast<int>(r + 1));
+                }
+                if (r + 1 < side) {
+                    sink(v + side, v, static_cast<int>(c + 1));
+                    sink(v, v + side, static_cast<int>(c + 1));
+                }
+            }
+        }
+    };
+    grid([&edges, &weights](size_t u, size_t v, int weight) {
+        edges.emplace_back(u, v);
+        weights.push_back(weight);
+    });
+    ariel::Graph expected;
+    expected.loadEdges(side * side, edges, weights);
+    ariel::StreamingGraphBuilder().build(g, grid);
+    CHECK(g.V() == expected.V());
+    CHECK(g.E() == expected.E());
+    CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+    bool same = true;
+    for (size_t u = 0; u < g.V(); ++u) {
+        same = same && g.outDegree(u) == expected.outDegree(u);
+        for (ariel::Neighbor edge : expected.neighbors(u))
+            same = same && g.getEdgeWeight(u, edge.vertex) == edge.weight;
+    }
+    CHECK(same);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, side * side - 1) ==
+          ariel::Algorithms::shortestPath(expected, 0, side * side - 1));
+
+    // bad input
+    size_t runs = 0;
+    auto changing = [&runs](const ariel::StreamingGraphBuilder::EdgeSink& sink) {
+        sink(0, 1, 1);
+        if (runs++ > 0)
+            sink(1, 0, 1);
+    };
+    CHECK_THROWS_AS(builder.build(g, changing), std::invalid_argument);
+    std::stringstream twice("0 1\n0 1 2\n");
+    CHECK_THROWS_AS(builder.build(g, twice), std::invalid_argument);
+    std::stringstream unreadable("0 1\n1 zero\n");
+    CHECK_THROWS_AS(builder.build(g, unreadable), std::invalid_argument);
+    // vertex numbers that leave no room for the vertex count
+    for (const char* line : {"18446744073709551614 0\n", "0 18446744073709551615\n"}) {
+        std::stringstream huge(line);
+        CHECK_THROWS_AS(builder.build(g, huge), std::invalid_argument);
+    }
+    auto huge = [](const ariel::StreamingGraphBuilder::EdgeSink& sink) {
+        sink(std::numeric_limits<size_t>::max(), 0, 1);
+    };
+    CHECK_THROWS_AS(builder.build(g, huge), std::invalid_argument);
+    CHECK_THROWS_AS(ariel::StreamingGraphBuilder(0), std::invalid_argument);
+}
+
+TEST_CASE("Test query workspace")
+{
+    ariel::QueryWorkspace workspace;
+    ariel::Graph g;
+    vector<vector<vector<int>>> graphs = {
+            {{0, 1, 0, 0, 0}, {1, 0, 1, 0, 0}, {0, 1, 0, 1, 0}, {0, 0, 1, 0, 1}, {0, 0, 0, 1, 0}},
+            {{0, 4, 1}, {0, 0, 0}, {0, 2, 0}},
+            {{0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 1}, {0, 0, 0, 0}},
+            {{0, 1, 2, 0, 0, 0}, {1, 0, 3, 0, 0, 0}, {2, 3, 0, 0, 0, 0}, {0, 0, 0, 0, -1, 0},
+             {0, 0, 0, -1, 0, 1}, {0, 0, 0, 0, 1, 0}},
+            {{0, -1, 0}, {0, 0, 0}, {0, 0, 0}}};
+    auto sameAnswers = [&workspace](const ariel::Graph& graph) {
+        CHECK(ariel::Algorithms::isConnected(graph, workspace) == ariel::Algorithms::isConnected(graph));
+        CHECK(ariel::Algorithms::isContainsCycle(graph, workspace) == ariel::Algorithms::isContainsCycle(graph));
+        CHECK(ariel::Algorithms::isBipartite(graph, workspace) == ariel::Algorithms::isBipartite(graph));
+        for (size_t u = 0; u < graph.V(); ++u) {
+            for (size_t v = 0; v < graph.V(); ++v) {
+                if (u != v)
+                    CHECK(ariel::Algorithms::shortestPath(graph, u, v, workspace) ==
+                          ariel::Algorithms::shortestPath(graph, u, v));
+            }
+        }
+    };
+    // the same workspace answers every query, on graphs of growing and shrinking sizes
+    for (const vector<vector<int>>& graph : graphs) {
+        g.loadGraph(graph, ariel::StorageLayout::SPARSE);
+        sameAnswers(g);
+        if (g.getEdgeType() == ariel::EdgeType::UNWEIGHTED) {
+            g.loadGraph(graph, ariel::StorageLayout::BITSET);
+            sameAnswers(g);
+        }
+    }
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 1, workspace) == "Shortest path from 0 to 1 is: 0->1");
+    // a vertex that a negative graph can't reach
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 2, workspace) == "There is no path from 0 to 2");
+    g.loadGraph(graphs[0]);
+    CHECK(ariel::Algorithms::shortestPath(g, 4, 0, workspace) == "Shortest path from 4 to 0 is: 4->3->2->1->0");
+    CHECK(ariel::Algorithms::isBipartite(g, workspace) == "Graph is bipartite, A={0,2,4}, B={1,3}");
+}
+
+TEST_CASE("Test lazy properties and degree statistics")
+{
+    // 0->1, 1->0, 1->2 (weight 3), 2->2 and a vertex 3 with no edges
+    ariel::Graph g;
+    g.loadEdges(4, {{0, 1}, {1, 0}, {1, 2}, {2, 2}}, {1, 1, 3, 1});
+    ariel::DegreeStatistics stats = g.getDegreeStatistics();
+    CHECK(stats.maxOutDegree == 2);
+    CHECK(stats.maxInDegree == 2);
+    CHECK(stats.selfLoops == 1);
+    CHECK(stats.averageDegree == doctest::Approx(1.0));
+    CHECK(stats.density == doctest::Approx(0.25));
+
+    // a copy shares the computed properties, and keeps them when the original is modified
+    ariel::Graph copy = g;
+    CHECK(g.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(g.getEdgeType() == ariel::EdgeType::WEIGHTED);
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NONE);
+    g.setWeight(1, 2, -1);
+    g.removeEdge(2, 2);
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+    CHECK(g.getDegreeStatistics().selfLoops == 0);
+    CHECK(copy.getEdgeNegativity() == ariel::EdgeNegativity::NONE);
+    CHECK(copy.getDegreeStatistics().selfLoops == 1);
+    g.addVertex();
+    CHECK(g.getDegreeStatistics().density == doctest::Approx(3.0 / 25));
+    CHECK(g.getEdgeNegativity() == ariel::EdgeNegativity::NEGATIVE);
+
+    // the reversed graph shares the properties, but not the statistics
+    ariel::Graph reversed = copy.getReversedGraph();
+    CHECK(reversed.getGraphType() == ariel::GraphType::DIRECTED);
+    CHECK(reversed.getDegreeStatistics().maxInDegree == 2);
+    CHECK(reversed.getDegreeStatistics().maxOutDegree == 2);
+
+    // the matrix loaders give every property right away, the statistics are the same in every layout
+    vector<vector<int>> star = {{0, 1, 1, 1}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}};
+    for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                        ariel::StorageLayout::BITSET, ariel::StorageLayout::COMPRESSED}) {
+        g.loadGraph(star, layout);
+        CHECK(g.getGraphType() == ariel::GraphType::UNDIRECTED);
+        CHECK(g.getDegreeStatistics().maxOutDegree == 3);
+        CHECK(g.getDegreeStatistics().maxInDegree == 3);
+        CHECK(g.getDegreeStatistics().selfLoops == 0);
+    }
+
+    // threads asking for the properties of a new graph at once all get the same answers
+    const size_t n = 2000;
+    vector<pair<size_t, size_t>> edges;
+    for (size_t v = 0; v + 1 < n; ++v) {
+        edges.emplace_back(v, v + 1);
+        edges.emplace_back(v + 1, v);
+    }
+    g.loadEdges(n, edges);
+    vector<int> answers(8, 0);
+    vector<std::thread> threads;
+    for (size_t t = 0; t < answers.size(); ++t) {
+        threads.emplace_back([&g, &answers, t] {
+            bool right = g.getGraphType() == ariel::GraphType::UNDIRECTED
+                         && g.getEdgeType() == ariel::EdgeType::UNWEIGHTED
+                         && g.getDegreeStatistics().maxOutDegree == 2;
+            answers[t] = right ? 1 : 0;
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+    CHECK(std::count(answers.begin(), answers.end(), 1) == 8);
+    CHECK(ariel::Algorithms::isConnected(g));
+}
+
+TEST_CASE("Test subgraph views")
+{
+    // a weighted path 0-1-2-3 and a triangle 4-5-6, joined by the directed edge 3->4
+    vector<vector<int>> matrix = {
+            {0, 2, 0, 0, 0, 0, 0},
+            {2, 0, 3, 0, 0, 0, 0},
+            {0, 3, 0, 1, 0, 0, 0},
+            {0, 0, 1, 0, 5, 0, 0},
+            {0, 0, 0, 0, 0, 1, 1},
+            {0, 0, 0, 0, 1, 0, 1},
+            {0, 0, 0, 0, 1, 1, 0}};
+    auto induced = [&matrix](const vector<bool>& keep) {
+        vector<vector<int>> sub;
+        for (size_t u = 0; u < matrix.size(); ++u) {
+            if (!keep[u])
+                continue;
+            sub.emplace_back();
+            for (size_t v = 0; v < matrix.size(); ++v) {
+                if (keep[v])
+                    sub.back().push_back(matrix[u][v]);
+            }
+        }
+        return sub;
+    };
+    vector<vector<bool>> subsets = {{true, true, true, true, false, false, false},
+                                    {false, false, false, false, true, true, true},
+                                    {false, true, true, true, true, false, true},
+                                    {true, true, true, true, true, true, true}};
+
+    // every algorithm answers on the view as on a graph loaded with the matrix of the subgraph
+    for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                        ariel::StorageLayout::COMPRESSED}) {
+        ariel::Graph parent;
+        parent.loadGraph(matrix, layout);
+        for (const vector<bool>& keep : subsets) {
+            ariel::Graph view;
+            view.loadSubgraphView(parent, keep);
+            ariel::Graph copied;
+            copied.loadGraph(induced(keep));
+            CHECK(view.isView());
+            CHECK(view.getStorageLayout() == ariel::StorageLayout::SUBGRAPH);
+            CHECK(view.V() == copied.V());
+            CHECK(view.E() == copied.E());
+            CHECK(view.getGraphType() == copied.getGraphType());
+            CHECK(ariel::Algorithms::isConnected(view) == ariel::Algorithms::isConnected(copied));
+            CHECK(ariel::Algorithms::isBipartite(view) == ariel::Algorithms::isBipartite(copied));
+            CHECK(ariel::Algorithms::isContainsCycle(view) == ariel::Algorithms::isContainsCycle(copied));
+            CHECK(ariel::Algorithms::negativeCycle(view) == ariel::Algorithms::negativeCycle(copied));
+            for (size_t u = 0; u < view.V(); ++u) {
+                CHECK(view.inDegree(u) == copied.inDegree(u));
+                for (size_t v = 0; v < view.V(); ++v) {
+                    CHECK(view.getEdgeWeight(u, v) == copied.getEdgeWeight(u, v));
+                    if (u != v)
+                        CHECK(ariel::Algorithms::shortestPath(view, u, v) == ariel::Algorithms::shortestPath(copied, u, v));
+                }
+            }
+        }
+    }
+
+    ariel::Graph parent;
+    parent.loadGraph(matrix);
+    ariel::Graph region;
+    region.loadSubgraphView(parent, subsets[2]);
+    CHECK(region.parentId(0) == 1);
+    CHECK(region.parentId(4) == 6);
+    CHECK(ariel::Algorithms::shortestPath(region, 0, 4) == "Shortest path from 0 to 4 is: 0->1->2->3->4");
+
+    // the edge predicate sees the vertices as the parent numbers them
+    ariel::Graph light;
+    light.loadSubgraphView(parent, subsets[3], [](size_t u, size_t v, int weight) {
+        return weight < 5 && !(u == 5 && v == 6);
+    });
+    CHECK(light.E() == 11);
+    CHECK(light.getEdgeWeight(3, 4) == 0);
+    CHECK(light.getEdgeWeight(5, 6) == 0);
+    CHECK(light.getEdgeWeight(6, 5) == 1);
+    CHECK(ariel::Algorithms::shortestPath(light, 0, 4) == "There is no path from 0 to 4");
+
+    // a view of a view, with a predicate of its own
+    ariel::Graph nested;
+    nested.loadSubgraphView(light, {false, false, false, false, true, true, true},
+                            [](size_t u, size_t, int) { return u != 4; });
+    CHECK(nested.V() == 3);
+    CHECK(nested.parentId(1) == 5);
+    CHECK(nested.E() == 3);
+    CHECK(nested.getEdgeWeight(2, 0) == 1);
+    CHECK(nested.getEdgeWeight(1, 2) == 0);
+
+    // a reordered parent is filtered by its original numbers
+    ariel::Graph reordered;
+    reordered.loadGraph(matrix);
+    reordered.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+    ariel::Graph view;
+    view.loadSubgraphView(reordered, subsets[2]);
+    CHECK(ariel::Algorithms::shortestPath(view, 0, 4) == ariel::Algorithms::shortestPath(region, 0, 4));
+    // its rows stay sorted, so the copies of the view read every edge back
+    for (ariel::VertexOrder order : {ariel::VertexOrder::REVERSE_CUTHILL_MCKEE, ariel::VertexOrder::DEGREE}) {
+        reordered.reorder(order);
+        for (const vector<bool>& keep : subsets) {
+            vector<vector<int>> sub = induced(keep);
+            size_t edges = 0;
+            for (const vector<int>& row : sub)
+                edges += static_cast<size_t>(std::count_if(row.begin(), row.end(), [](int w) { return w != 0; }));
+            ariel::Graph base;
+            base.loadSubgraphView(reordered, keep);
+            ariel::Graph compressed = base;
+            compressed.compress();
+            ariel::Graph edited = base;
+            edited.makeEditable();
+            for (const ariel::Graph* g : {&base, &compressed, &edited}) {
+                CHECK(g->E() == edges);
+                for (size_t u = 0; u < sub.size(); ++u) {
+                    size_t previous = 0;
+                    bool first = true;
+                    for (ariel::Neighbor edge : g->neighbors(u)) {
+                        CHECK((first || edge.vertex > previous));
+                        previous = edge.vertex;
+                        first = false;
+                    }
+                    for (size_t v = 0; v < sub.size(); ++v)
+                        CHECK(g->getEdgeWeight(g->internalId(u), g->internalId(v)) == sub[u][v]);
+                }
+                CHECK(ariel::Algorithms::negativeCycle(*g) == "No negative cycle detected in the graph");
+            }
+            // edits go to the right edges
+            ariel::Graph changed = base;
+            for (size_t u = 0; u < sub.size(); ++u) {
+                for (size_t v = 0; v < sub.size(); ++v) {
+                    if (sub[u][v] != 0)
+                        changed.setWeight(changed.internalId(u), changed.internalId(v), sub[u][v] + 10);
+                }
+            }
+            for (size_t u = 0; u < sub.size(); ++u) {
+                for (size_t v = 0; v < sub.size(); ++v)
+                    CHECK(changed.getEdgeWeight(changed.internalId(u), changed.internalId(v)) ==
+                          (sub[u][v] != 0 ? sub[u][v] + 10 : 0));
+            }
+        }
+    }
+    // a view of a view of a reordered graph, with predicates in the numbers of each parent
+    ariel::Graph heavy;
+    heavy.loadSubgraphView(reordered, subsets[3], [](size_t u, size_t v, int) { return !(u == 3 && v == 4); });
+    ariel::Graph tail;
+    tail.loadSubgraphView(heavy, subsets[2], [](size_t u, size_t, int) { return u != 6; });
+    CHECK(tail.parentId(4) == 6);
+    CHECK(tail.E() == 5);
+    CHECK(tail.getEdgeWeight(tail.internalId(2), tail.internalId(3)) == 0);
+    CHECK(tail.getEdgeWeight(tail.internalId(3), tail.internalId(4)) == 1);
+    CHECK(tail.getEdgeWeight(tail.internalId(4), tail.internalId(3)) == 0);
+    CHECK(tail.getEdgeWeight(tail.internalId(2), tail.internalId(1)) == 1);
+
+    // the reversed view and the first modification copy the edges, the parent stays as it was
+    ariel::Graph reversed = region.getReversedGraph();
+    CHECK(reversed.getEdgeWeight(3, 2) == 5);
+    CHECK(reversed.getEdgeWeight(2, 3) == 0);
+    region.setWeight(0, 4, 7);
+    CHECK(!region.isView());
+    CHECK(region.getEdgeWeight(0, 4) == 7);
+    CHECK(region.getEdgeWeight(0, 1) == 3);
+    CHECK(parent.getEdgeWeight(1, 6) == 0);
+
+    // bad input
+    CHECK_THROWS_AS(view.loadSubgraphView(parent, vector<bool>(3, true)), std::invalid_argument);
+    CHECK_THROWS_AS(parent.loadSubgraphView(parent, subsets[0]), std::invalid_argument);
+    CHECK_THROWS_AS(parent.loadSubgraphView(light, subsets[0]), std::invalid_argument);
+    CHECK_THROWS_AS(view.loadGraph(matrix, ariel::StorageLayout::SUBGRAPH), std::invalid_argument);
+}
+
+TEST_CASE("Test versioned graph snapshots")
+{
+    const size_t n = 300;
+    vector<pair<size_t, size_t>> edges;
+    for (size_t v = 0; v + 1 < n; ++v)
+        edges.emplace_back(v, v + 1);
+    ariel::Graph path;
+    path.loadEdges(n, edges);
+    ariel::VersionedGraph versions(path);
+    ariel::GraphSnapshot first = versions.snapshot();
+    CHECK(first.version == 0);
+    CHECK(first.graph->getStorageLayout() == ariel::StorageLayout::DYNAMIC);
+
+    // every version keeps its own edges, the later ones don't show through
+    CHECK(versions.update([](ariel::Graph& g) { g.addEdge(n - 1, 0); }) == 1);
+    ariel::GraphSnapshot second = versions.snapshot();
+    CHECK(versions.update([](ariel::Graph& g) {
+        g.setWeight(0, 1, 4);
+        g.addVertex();
+    }) == 2);
+    ariel::GraphSnapshot third = versions.snapshot();
+    CHECK(ariel::Algorithms::isConnected(*first.graph) == false);
+    CHECK(ariel::Algorithms::isConnected(*second.graph) == true);
+    CHECK(ariel::Algorithms::isConnected(*third.graph) == false);
+    CHECK(first.graph->getEdgeWeight(0, 1) == 1);
+    CHECK(second.graph->getEdgeWeight(0, 1) == 1);
+    CHECK(third.graph->getEdgeWeight(0, 1) == 4);
+    CHECK(first.graph->E() == n - 1);
+    CHECK(second.graph->E() == n);
+    CHECK(third.graph->V() == n + 1);
+    CHECK(third.graph->getEdgeType() == ariel::EdgeType::WEIGHTED);
+    CHECK(second.graph->getEdgeType() == ariel::EdgeType::UNWEIGHTED);
+
+    // a change that throws publishes nothing
+    CHECK_THROWS_AS(versions.update([](ariel::Graph& g) {
+        g.removeEdge(1, 2);
+        g.removeEdge(1, 2);
+    }), std::invalid_argument);
+    CHECK(versions.version() == 2);
+    CHECK(versions.snapshot().graph->getEdgeWeight(1, 2) == 1);
+
+    // readers query while a writer publishes: every snapshot holds exactly the edges of its version
+    versions.update([](ariel::Graph& g) { g.removeEdge(n - 1, 0); });
+    const size_t updates = 200;
+    std::thread writer([&versions] {
+        for (size_t i = 0; i < updates; ++i)
+            versions.update([i](ariel::Graph& g) { g.addEdge(n - 1 - i % (n - 1), 0, static_cast<int>(i + 1)); });
+    });
+    vector<int> consistent(4, 1);
+    vector<std::thread> readers;
+    for (size_t t = 0; t < consistent.size(); ++t) {
+        readers.emplace_back([&versions, &consistent, t] {
+            for (size_t i = 0; i < 50; ++i) {
+                ariel::GraphSnapshot s = versions.snapshot();
+                size_t added = s.version - 3;
+                bool right = s.graph->E() == n - 1 + added && s.graph->outDegree(0) == 1
+                             && s.graph->inDegree(0) == added;
+                if (added > 0)
+                    right = right && s.graph->getEdgeWeight(n - 1 - (added - 1) % (n - 1), 0) == static_cast<int>(added);
+                if (!right)
+                    consistent[t] = 0;
+            }
+        });
+    }
+    writer.join();
+    for (std::thread& reader : readers)
+        reader.join();
+    CHECK(std::count(consistent.begin(), consistent.end(), 1) == 4);
+    CHECK(versions.version() == 3 + updates);
+    CHECK(first.graph->E() == n - 1);
+}
+
+TEST_CASE("Test concurrent query executor")
+{
+    // a 6x6 grid with weights by position, loaded from edges so the threads race for its lazy properties
+    const size_t side = 6;
+    vector<pair<size_t, size_t>> edges;
+    vector<int> weights;
+    for (size_t r = 0; r < side; ++r) {
+        for (size_t c = 0; c < side; ++c) {
+            size_t u = r * side + c;
+            if (c + 1 < side) {
+                edges.push_back({u, u + 1});
+                edges.push_back({u + 1, u});
+                weights.push_back(static_cast<int>(r + 1));
+                weights.push_back(static_cast<int>(r + 1));
+            }
+            if (r + 1 < side) {
+                edges.push_back({u, u + side});
+                edges.push_back({u + side, u});
+                weights.push_back(static_cast<int>(c + 2));
+                weights.push_back(static_cast<int>(c + 2));
+            }
+        }
+    }
+    vector<ariel::Query> queries;
+    for (size_t u = 0; u < side * side; u += 5) {
+        for (size_t v = 0; v < side * side; v += 3) {
+            if (u != v)
+                queries.push_back({ariel::QueryKind::SHORTEST_PATH, u, v});
+        }
+        queries.push_back({ariel::QueryKind::IS_CONNECTED, 0, 0});
+        queries.push_back({ariel::QueryKind::IS_BIPARTITE, 0, 0});
+        queries.push_back({ariel::QueryKind::CONTAINS_CYCLE, 0, 0});
+    }
+
+    ariel::Graph expectedGraph;
+    expectedGraph.loadEdges(side * side, edges, weights);
+    vector<string> expected;
+    for (const ariel::Query& query : queries) {
+        if (query.kind == ariel::QueryKind::SHORTEST_PATH)
+            expected.push_back(ariel::Algorithms::shortestPath(expectedGraph, query.source, query.dest));
+        else if (query.kind == ariel::QueryKind::IS_CONNECTED)
+            expected.push_back(ariel::Algorithms::isConnected(expectedGraph) ? "true" : "false");
+        else if (query.kind == ariel::QueryKind::IS_BIPARTITE)
+            expected.push_back(ariel::Algorithms::isBipartite(expectedGraph));
+        else
+            expected.push_back(ariel::Algorithms::isContainsCycle(expectedGraph));
+    }
+
+    for (size_t threads : {1u, 2u, 4u}) {
+        ariel::QueryExecutor executor(threads);
+        CHECK(executor.threads() == threads);
+        ariel::Graph g;
+        g.loadEdges(side * side, edges, weights);
+        // the same pool runs batch after batch
+        for (size_t round = 0; round < 3; ++round) {
+            ariel::QueryBatchResult result = executor.run(g, queries);
+            CHECK(result.answers == expected);
+            CHECK(result.seconds >= 0);
+            CHECK(result.queriesPerSecond >= 0);
+        }
+        CHECK(executor.run(g, {}).answers.empty());
+    }
+
+    ariel::QueryExecutor executor;
+    CHECK(executor.threads() >= 1);
+    ariel::Graph g;
+    g.loadGraph({{0, 1, 0}, {1, 0, 1}, {0, 1, 0}});
+    ariel::QueryBatchResult result = executor.run(g, {{ariel::QueryKind::SHORTEST_PATH, 2, 0},
+                                                      {ariel::QueryKind::IS_BIPARTITE, 0, 0}});
+    CHECK(result.answers[0] == "Shortest path from 2 to 0 is: 2->1->0");
+    CHECK(result.answers[1] == "Graph is bipartite, A={0,2}, B={1}");
+    // a bad query fails the batch once the other queries are done, and the pool keeps working
+    CHECK_THROWS_AS(executor.run(g, {{ariel::QueryKind::IS_CONNECTED, 0, 0},
+                                     {ariel::QueryKind::SHORTEST_PATH, 0, 3}}), std::invalid_argument);
+    CHECK(executor.run(g, {{ariel::QueryKind::IS_CONNECTED, 0, 0}}).answers[0] == "true");
+}
+
+TEST_CASE("Test typed algorithm results")
+{
+    ariel::Graph g;
+    // weighted directed: 0->1 (4), 0->2 (1), 2->1 (2)
+    g.loadGraph({{0, 4, 1}, {0, 0, 0}, {0, 2, 0}});
+    ariel::PathResult path = ariel::Algorithms::findShortestPath(g, 0, 1);
+    CHECK(path.status == ariel::PathStatus::FOUND);
+    CHECK(path.vertices == vector<size_t>{0, 2, 1});
+    CHECK(path.cost == 3);
+    ariel::PathResult noPath = ariel::Algorithms::findShortestPath(g, 1, 0);
+    CHECK(noPath.status == ariel::PathStatus::NO_PATH);
+    CHECK(noPath.vertices.empty());
+    CHECK(ariel::toMessage(noPath) == "There is no path from 1 to 0");
+    CHECK(ariel::Algorithms::findCycle(g).status == ariel::CycleStatus::NO_CYCLE);
+    CHECK(ariel::Algorithms::findNegativeCycle(g).status == ariel::CycleStatus::NO_CYCLE);
+
+    // unweighted undirected path 0-1-2-3-4
+    g.loadGraph({{0, 1, 0, 0, 0}, {1, 0, 1, 0, 0}, {0, 1, 0, 1, 0}, {0, 0, 1, 0, 1}, {0, 0, 0, 1, 0}});
+    path = ariel::Algorithms::findShortestPath(g, 4, 1);
+    CHECK(path.vertices == vector<size_t>{4, 3, 2, 1});
+    CHECK(path.cost == 3);
+    ariel::BipartiteResult sides = ariel::Algorithms::findBipartition(g);
+    CHECK(sides.status == ariel::BipartiteStatus::BIPARTITE);
+    CHECK(sides.inA == vector<bool>{true, false, true, false, true});
+    std::ostringstream out;
+    out << sides << "; " << path;
+    CHECK(out.str() == "Graph is bipartite, A={0,2,4}, B={1,3}; Shortest path from 4 to 1 is: 4->3->2->1");
+
+    // the results name the vertices by their original numbers after a reorder
+    g.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+    CHECK(ariel::Algorithms::findShortestPath(g, 4, 1).vertices == vector<size_t>{4, 3, 2, 1});
+    CHECK(ariel::Algorithms::findBipartition(g).inA == vector<bool>{true, false, true, false, true});
+
+    // a triangle and a negative cycle
+    g.loadGraph({{0, 1, 0}, {0, 0, 1}, {1, 0, 0}});
+    ariel::CycleResult cycle = ariel::Algorithms::findCycle(g);
+    CHECK(cycle.status == ariel::CycleStatus::FOUND);
+    CHECK(cycle.vertices == vector<size_t>{0, 1, 2, 0});
+    CHECK(ariel::toMessage(cycle) == ariel::Algorithms::isContainsCycle(g));
+    CHECK(ariel::Algorithms::findBipartition(g).status == ariel::BipartiteStatus::NOT_BIPARTITE);
+    CHECK(ariel::Algorithms::findBipartition(g).inA.empty());
+    g.loadGraph({{0, 1, 0}, {0, 0, -3}, {1, 0, 0}});
+    ariel::NegativeCycleResult negative = ariel::Algorithms::findNegativeCycle(g);
+    CHECK(negative.status == ariel::CycleStatus::FOUND);
+    CHECK(negative.vertices.size() == 4);
+    CHECK(negative.vertices.front() == negative.vertices.back());
+    CHECK(ariel::toMessage(negative) == ariel::Algorithms::negativeCycle(g));
+
+    // a negative edge outside any cycle: Bellman-Ford, with the cost of the path
+    g.loadGraph({{0, 5, 2}, {0, 0, 0}, {0, -1, 0}});
+    ariel::QueryWorkspace workspace;
+    path = ariel::Algorithms::findShortestPath(g, 0, 1, workspace);
+    CHECK(path.vertices == vector<size_t>{0, 2, 1});
+    CHECK(path.cost == 1);
+
+    ariel::Graph empty;
+    CHECK(ariel::Algorithms::findCycle(empty, workspace).status == ariel::CycleStatus::EMPTY_GRAPH);
+    CHECK(ariel::Algorithms::findBipartition(empty, workspace).status == ariel::BipartiteStatus::EMPTY_GRAPH);
+    CHECK(ariel::toMessage(ariel::Algorithms::findBipartition(empty)) == "Graph is empty");
+    CHECK_THROWS_AS(ariel::Algorithms::findShortestPath(empty, 0, 0), std::invalid_argument);
+}
+
+TEST_CASE("Test shortest path trees")
+{
+    ariel::Graph g;
+    ariel::QueryWorkspace workspace;
+    vector<vector<vector<int>>> graphs = {
+            {{0, 1, 0, 0, 0}, {1, 0, 1, 0, 0}, {0, 1, 0, 1, 0}, {0, 0, 1, 0, 1}, {0, 0, 0, 1, 0}},
+            {{0, 4, 1, 0}, {0, 0, 0, 1}, {0, 2, 0, 6}, {0, 0, 0, 0}},
+            {{0, 1, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 1}, {0, 0, 0, 0}},
+            {{0, 5, 2, 0}, {0, 0, 0, 1}, {0, -1, 0, 0}, {0, 0, 0, 0}}};
+    // every path of the tree is a path of the graph, as short as the one Find gives
+    auto sameAsFind = [&g, &workspace]() {
+        for (size_t s = 0; s < g.V(); ++s) {
+            ariel::ShortestPathTree tree = ariel::Algorithms::shortestPathTree(g, s, workspace);
+            CHECK(tree.source() == s);
+            CHECK(tree.size() == g.V());
+            CHECK(tree.distance(s) == 0);
+            CHECK(tree.parent(s) == ariel::ShortestPathTree::NO_VERTEX);
+            for (size_t d = 0; d < g.V(); ++d) {
+                if (d == s)
+                    continue;
+                ariel::PathResult expected = ariel::Algorithms::findShortestPath(g, s, d);
+                ariel::PathResult path = tree.path(d);
+                CHECK(path.status == expected.status);
+                CHECK(tree.reaches(d) == (expected.status == ariel::PathStatus::FOUND));
+                if (path.status != ariel::PathStatus::FOUND)
+                    continue;
+                CHECK(path.cost == expected.cost);
+                CHECK(tree.distance(d) == expected.cost);
+                CHECK(path.vertices.front() == s);
+                CHECK(path.vertices.back() == d);
+                ariel::Distance cost = 0;
+                for (size_t i = 0; i + 1 < path.vertices.size(); ++i)
+                    cost += g.getEdgeWeight(g.internalId(path.vertices[i]), g.internalId(path.vertices[i + 1]));
+                CHECK(cost == path.cost);
+            }
+        }
+    };
+    for (const vector<vector<int>>& graph : graphs) {
+        g.loadGraph(graph, ariel::StorageLayout::SPARSE);
+        sameAsFind();
+        g.reorder(ariel::VertexOrder::DEGREE);
+        sameAsFind();
+        if (g.getEdgeType() == ariel::EdgeType::UNWEIGHTED) {
+            g.loadGraph(graph, ariel::StorageLayout::BITSET);
+            sameAsFind();
+        }
+    }
+
+    g.loadGraph(graphs[1]);
+    ariel::ShortestPathTree tree = ariel::Algorithms::shortestPathTree(g, 0);
+    CHECK(tree.path(3).vertices == vector<size_t>{0, 2, 1, 3});
+    CHECK(tree.path(0).vertices == vector<size_t>{0});
+    CHECK(tree.path(0).cost == 0);
+    CHECK(tree.distance(1) == 3);
+    CHECK(tree.parent(1) == 2);
+    CHECK(ariel::toMessage(tree.path(3)) == "Shortest path from 0 to 3 is: 0->2->1->3");
+    // the tree keeps its answers after the graph changes
+    g.removeEdge(2, 1);
+    CHECK(tree.distance(1) == 3);
+    tree = ariel::Algorithms::shortestPathTree(g, 3);
+    CHECK(tree.reaches(0) == false);
+    CHECK(tree.distance(0) == std::numeric_limits<ariel::Distance>::max());
+    CHECK(ariel::toMessage(tree.path(0)) == "There is no path from 3 to 0");
+    CHECK_THROWS_AS((void)tree.path(4), std::invalid_argument);
+    CHECK_THROWS_AS(ariel::Algorithms::shortestPathTree(g, 4), std::invalid_argument);
+    g.loadGraph({{0, 1, 0}, {0, 0, -3}, {1, 0, 0}});
+    CHECK_THROWS_AS(ariel::Algorithms::shortestPathTree(g, 0), std::invalid_argument);
+}
+
+TEST_CASE("Test point to point dijkstra")
+{
+    // a weighted path 0-1-2-...-(n-1), with a costly shortcut 0-(n-1)
+    const size_t n = 200;
+    vector<pair<size_t, size_t>> edges;
+    vector<int> weights;
+    for (size_t v = 0; v + 1 < n; ++v) {
+        edges.push_back({v, v + 1});
+        edges.push_back({v + 1, v});
+        weights.push_back(2);
+        weights.push_back(2);
+    }
+    edges.push_back({0, n - 1});
+    edges.push_back({n - 1, 0});
+    weights.push_back(1000);
+    weights.push_back(1000);
+    ariel::Graph g;
+    g.loadEdges(n, edges, weights);
+    ariel::QueryWorkspace workspace;
+
+    // the search stops once the destination is settled, a local query settles a few vertices
+    ariel::PathResult path = ariel::Algorithms::findShortestPath(g, 0, 3, workspace);
+    CHECK(path.vertices == vector<size_t>{0, 1, 2, 3});
+    CHECK(path.cost == 6);
+    CHECK(path.settled <= 8);
+    path = ariel::Algorithms::findShortestPath(g, 5, 4, workspace);
+    CHECK(path.vertices == vector<size_t>{5, 4});
+    CHECK(path.settled <= 3);
+    // stale heap entries are skipped: every vertex is settled at most once
+    path = ariel::Algorithms::findShortestPath(g, 0, n / 2, workspace);
+    CHECK(path.cost == static_cast<ariel::Distance>(n));
+    CHECK(path.settled <= n);
+    path = ariel::Algorithms::findShortestPath(g, 0, n - 1, workspace);
+    CHECK(path.cost == 398);
+    CHECK(path.settled <= n);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, n - 1, workspace) == ariel::Algorithms::shortestPath(g, 0, n - 1));
+
+    // BFS counts the vertices it dequeued
+    g.loadGraph({{0, 1, 0, 0}, {1, 0, 1, 0}, {0, 1, 0, 1}, {0, 0, 1, 0}});
+    CHECK(ariel::Algorithms::findShortestPath(g, 0, 1).settled == 2);
+    CHECK(ariel::Algorithms::findShortestPath(g, 0, 3).settled == 4);
+
+    // the early stop gives the same paths, ties included
+    g.loadGraph({{0, 1, 1, 0}, {0, 0, 0, 1}, {0, 0, 0, 1}, {0, 0, 0, 0}}, ariel::StorageLayout::SPARSE);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->1->3");
+    g.loadGraph({{0, 2, 1, 0}, {0, 0, 0, 1}, {0, 0, 0, 2}, {0, 0, 0, 0}}, ariel::StorageLayout::SPARSE);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->1->3");
+    CHECK(ariel::Algorithms::findShortestPath(g, 0, 2).settled == 2);
+    // the paths follow the predecessors recorded by the search, after updates too
+    g.loadGraph({{0, 2, 1, 0}, {0, 0, 0, 1}, {0, 0, 0, 2}, {0, 0, 0, 0}}, ariel::StorageLayout::DYNAMIC);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->1->3");
+    g.setWeight(2, 3, 1);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->2->3");
+    g.setWeight(1, 3, 0);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3) == "Shortest path from 0 to 3 is: 0->2->3");
+}
+
+TEST_CASE("Test bidirectional dijkstra")
+{
+    // random weighted graphs, directed and undirected, in every layout that keeps weights
+    ariel::QueryWorkspace workspace;
+    ariel::QueryWorkspace bidirectionalWorkspace;
+    ariel::PathOptions bidirectional(ariel::PathSearch::BIDIRECTIONAL);
+    unsigned int seed = 7;
+    auto next = [&seed](unsigned int bound) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % bound;
+    };
+    for (size_t round = 0; round < 6; ++round) {
+        const size_t n = 12;
+        vector<vector<int>> matrix(n, vector<int>(n, 0));
+        for (size_t u = 0; u < n; ++u) {
+            for (size_t v = 0; v < n; ++v) {
+                if (u != v && next(4) == 0) {
+                    matrix[u][v] = static_cast<int>(1 + next(9));
+                    if (round % 2 == 1)
+                        matrix[v][u] = matrix[u][v];
+                }
+            }
+        }
+        for (ariel::StorageLayout layout : {ariel::StorageLayout::SPARSE, ariel::StorageLayout::DENSE,
+                                            ariel::StorageLayout::COMPRESSED}) {
+            ariel::Graph g;
+            g.loadGraph(matrix, layout);
+            if (round == 4)
+                g.reorder(ariel::VertexOrder::REVERSE_CUTHILL_MCKEE);
+            for (size_t s = 0; s < n; ++s) {
+                for (size_t d = 0; d < n; ++d) {
+                    ariel::PathResult expected = ariel::Algorithms::findShortestPath(g, s, d, workspace);
+                    ariel::PathResult path = ariel::Algorithms::findShortestPath(g, s, d, bidirectional,
+                                                                                 bidirectionalWorkspace);
+                    CHECK(path.status == expected.status);
+                    CHECK(path.cost == expected.cost);
+                    if (path.status != ariel::PathStatus::FOUND)
+                        continue;
+                    CHECK(path.vertices.front() == s);
+                    CHECK(path.vertices.back() == d);
+                    ariel::Distance cost = 0;
+                    for (size_t i = 0; i + 1 < path.vertices.size(); ++i)
+                        cost += g.getEdgeWeight(g.internalId(path.vertices[i]), g.internalId(path.vertices[i + 1]));
+                    CHECK(cost == path.cost);
+                }
+            }
+        }
+    }
+
+    // on a long path the two searches meet half way, together they settle about as much as one does
+    const size_t n = 301;
+    vector<pair<size_t, size_t>> edges;
+    vector<int> weights;
+    for (size_t v = 0; v + 1 < n; ++v) {
+        edges.push_back({v, v + 1});
+        weights.push_back(3);
+    }
+    ariel::Graph g;
+    g.loadEdges(n, edges, weights);
+    ariel::PathResult path = ariel::Algorithms::findShortestPath(g, 0, n - 1, bidirectional, workspace);
+    CHECK(path.cost == 900);
+    CHECK(path.vertices.size() == n);
+    CHECK(path.settled <= n + 1);
+    CHECK(ariel::Algorithms::findShortestPath(g, n - 1, 0, bidirectional, workspace).status ==
+          ariel::PathStatus::NO_PATH);
+    CHECK(ariel::Algorithms::shortestPath(g, 2, 5, bidirectional) == "Shortest path from 2 to 5 is: 2->3->4->5");
+    CHECK(ariel::Algorithms::shortestPath(g, 2, 5, bidirectional, workspace) ==
+          "Shortest path from 2 to 5 is: 2->3->4->5");
+    CHECK(ariel::Algorithms::shortestPath(g, 5, 5, bidirectional) ==
+          ariel::Algorithms::shortestPath(g, 5, 5));
+
+    // unweighted graphs are searched with every edge weighing 1, negative weights are refused
+    g.loadGraph({{0, 1, 0, 0}, {1, 0, 1, 0}, {0, 1, 0, 1}, {0, 0, 1, 0}}, ariel::StorageLayout::BITSET);
+    CHECK(ariel::Algorithms::shortestPath(g, 0, 3, bidirectional) ==
+          "Shortest path from 0 to 3 is: 0->1->2->3");
+    g.loadGraph({{0, 5, 2}, {0, 0, 0}, {0, -1, 0}});
+    CHECK_THROWS_AS(ariel::Algorithms::shortestPath(g, 0, 1, bidirectional),
+                    std::invalid_argument);
+}
+
+TEST_CASE("Test A* and landmark search")
+{
+    // random weighted graphs, directed and undirected: ALT and A* find paths as short as Dijkstra's
+    unsigned int seed = 11;
+    auto next = [&seed](unsigned int bound) {
+        seed = seed * 1103515245u + 12345u;
+        return (seed >> 16) % bound;
+    };
+    ariel::QueryWorkspace workspace;
+    for (size_t round = 0; round < 4; ++round) {
+        const size_t n = 14;
+        vector<vector<int>> matrix(n, vector<int>(n, 0));
+        for (size_t u = 0; u < n; ++u) {
+            for (size_t v = 0; v < n; ++v) {
+                if (u != v && next(4) == 0) {
+                    matrix[u][v] = static_cast<int>(1 + next(9));
+                    if (round % 2 == 1)
+                        matrix[v][u] = matrix[u][v];
+                }
+            }
+        }
+        ariel::Graph g;
+        g.loadGraph(matrix);
+        if (round == 2)
+            g.reorder(ariel::VertexOrder::DEGREE);
+        ariel::Landmarks landmarks(g, 3);
+        CHECK(landmarks.size() == 3);
+        for (size_t s = 0; s < n; ++s) {
+            ariel::ShortestPathTree tree = ariel::Algorithms::shortestPathTree(g, s);
+            for (size_t d = 0; d < n; ++d) {
+                // the bounds never pass the distances
+                if (tree.reaches(d))
+                    CHECK(landmarks.lowerBound(s, d) <= tree.distance(d));
+                if (s == d)
+                    continue;
+                ariel::PathResult expected = ariel::Algorithms::findShortestPath(g, s, d);
+                ariel::PathResult alt = ariel::Algorithms::findShortestPath(g, s, d, ariel::PathOptions(landmarks), workspace);
+                ariel::PathResult zero = ariel::Algorithms::findShortestPath(
+                        g, s, d, ariel::PathOptions([](size_t, size_t) { return ariel::Distance(0); }), workspace);
+                CHECK(alt.status == expected.status);
+                CHECK(alt.cost == expected.cost);
+                CHECK(zero.status == expected.status);
+                CHECK(zero.cost == expected.cost);
+                if (alt.status == ariel::PathStatus::FOUND) {
+                    CHECK(alt.vertices.front() == s);
+                    CHECK(alt.vertices.back() == d);
+                }
+            }
+        }
+    }
+
+    // on a path the search heads for the destination, where Dijkstra spreads both ways
+    const size_t n = 201;
+    vector<vector<int>> matrix(n, vector<int>(n, 0));
+    for (size_t v = 0; v + 1 < n; ++v) {
+        matrix[v][v + 1] = 2;
+        matrix[v + 1][v] = 2;
+    }
+    ariel::Graph g;
+    g.loadGraph(matrix);
+    ariel::PathHeuristic exact = [](size_t v, size_t dest) {
+        return static_cast<ariel::Distance>(2 * (v > dest ? v - dest : dest - v));
+    };
+    ariel::PathResult dijkstra = ariel::Algorithms::findShortestPath(g, 100, 180);
+    ariel::PathResult aStar = ariel::Algorithms::findShortestPath(g, 100, 180, ariel::PathOptions(exact), workspace);
+    CHECK(aStar.cost == 160);
+    CHECK(aStar.vertices == dijkstra.vertices);
+    CHECK(aStar.settled <= 82);
+    CHECK(dijkstra.settled > 150);
+    // farthest point selection puts the landmarks at the two ends, which bound every distance exactly
+    ariel::Landmarks ends(g, 2);
+    CHECK(((ends.vertices()[0] == 0 && ends.vertices()[1] == n - 1) ||
+           (ends.vertices()[0] == n - 1 && ends.vertices()[1] == 0)));
+    CHECK(ends.lowerBound(100, 180) == 160);
+    ariel::PathResult alt = ariel::Algorithms::findShortestPath(g, 100, 180, ariel::PathOptions(ends), workspace);
+    CHECK(alt.cost == 160);
+    CHECK(alt.settled <= 82);
+    CHECK(ariel::Algorithms::shortestPath(g, 3, 1, ariel::PathOptions(ends)) == "Shortest path from 3 to 1 is: 3->2->1");
+    CHECK(ariel::Algorithms::shortestPath(g, 3, 1, ariel::PathOptions(exact), workspace) == "Shortest path from 3 to 1 is: 3->2->1");
+    // one search at a time
+    ariel::PathOptions both(ends);
+    both.heuristic = exact;
+    CHECK_THROWS_AS(ariel::Algorithms::findShortestPath(g, 3, 1, both), std::invalid_argument);
+    ariel::PathOptions bidirectional(exact);
+    bidirectional.search = ariel::PathSearch::BIDIRECTIONAL;
+    CHECK_THROWS_AS(ariel::Algorithms::shortestPath(g, 3, 1, bidirectional), std::invalid_argument);
+
+    // landmarks need the graph they were computed on, and weights that aren't negative
+    g.loadGraph({{0, 1, 0}, {1, 0, 1}, {0, 1, 0}});
+    CHECK_THROWS_AS(ariel::Algorithms::shortestPath(g, 0, 2, ariel::PathOptions(ends)), std::invalid_argument);
+    CHECK_THROWS_AS(ariel::Landmarks(g, 0), std::invalid_argument);
+    CHECK(ariel::Landmarks(g, 5).size() == 3);
+    g.loadGraph({{0, 5, 2}, {0, 0, 0}, {0, -1, 0}});
+    CHECK_THROWS_AS(ariel::Landmarks(g, 1), std::invalid_argument);
+    CHECK_THROWS_AS(ariel::Algorithms::shortestPath(g, 0, 1, ariel::PathOptions(exact)), std::invalid_argument);
+}
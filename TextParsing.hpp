@@ -0,0 +1,195 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef TEXT_PARSING_HPP
+#define TEXT_PARSING_HPP
+
+#include "GraphProperties.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ * Reading numbers and edge lines out of text that is not null terminated (a mapped file or a
+ * buffer of a stream), shared by the graph file loaders. Every function reads [p, end).
+ */
+
+namespace ariel {
+    namespace text {
+
+        // the largest vertex number a file can name: the graph has one more vertex than it, and one
+        // more row offset than vertices, which must still be counted in a size_t
+        const size_t MAX_VERTEX_INDEX = std::numeric_limits<size_t>::max() - 2;
+
+        inline bool isSpace(char c) {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        inline bool isDigit(char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        inline bool atLineEnd(const char* p, const char* end) {
+            return p == end || *p == '\n';
+        }
+
+        inline bool atFieldEnd(const char* p, const char* end) {
+            return atLineEnd(p, end) || isSpace(*p);
+        }
+
+        inline void skipSpaces(const char*& p, const char* end) {
+            while (p < end && isSpace(*p))
+                ++p;
+        }
+
+        inline const char* nextLine(const char* p, const char* end) {
+            const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+            return newline != nullptr ? static_cast<const char*>(newline) + 1 : end;
+        }
+
+        inline std::invalid_argument lineError(const char* line, const char* end) {
+            const char* lineEnd = std::min(nextLine(line, end), line + 80);
+            while (lineEnd > line && (lineEnd[-1] == '\n' || lineEnd[-1] == '\r'))
+                --lineEnd;
+            return std::invalid_argument("Invalid graph file: cannot read the line \"" + std::string(line, lineEnd) + "\".");
+        }
+
+        /**
+         * Reads a number that fits a size_t.
+         */
+        inline bool parseIndex(const char*& p, const char* end, size_t& value) {
+            skipSpaces(p, end);
+            const char* digits = p;
+            value = 0;
+            while (p < end && isDigit(*p)) {
+                size_t digit = static_cast<size_t>(*p - '0');
+                if (value > (std::numeric_limits<size_t>::max() - digit) / 10)
+                    return false;
+                value = value * 10 + digit;
+                ++p;
+            }
+            return p != digits && atFieldEnd(p, end);
+        }
+
+        /**
+         * Converts a whole number read as a sign and a magnitude to a weight, if it fits one.
+         */
+        inline bool toWeight(uint64_t magnitude, bool negative, Weight& value, std::true_type) {
+            typedef std::numeric_limits<Weight> limits;
+            uint64_t largest = static_cast<uint64_t>(limits::max());
+            if (negative)
+                largest = limits::is_signed ? largest + 1 : 0;
+            if (magnitude > largest)
+                return false;
+            // -(magnitude - 1) - 1 reaches the lowest weight without overflowing
+            value = negative && magnitude != 0 ? static_cast<Weight>(-static_cast<int64_t>(magnitude - 1) - 1)
+                                               : static_cast<Weight>(magnitude);
+            return true;
+        }
+
+        inline bool toWeight(uint64_t magnitude, bool negative, Weight& value, std::false_type) {
+            value = static_cast<Weight>(magnitude);
+            if (negative)
+                value = -value;
+            return true;
+        }
+
+        inline bool toWeight(double real, Weight& value, std::true_type) {
+            typedef std::numeric_limits<Weight> limits;
+            // the largest weight may round up as a double, one below it does not
+            if (real != std::floor(real) || real < static_cast<double>(limits::min())
+                || real - 1 >= static_cast<double>(limits::max()))
+                return false;
+            value = static_cast<Weight>(real);
+            return true;
+        }
+
+        inline bool toWeight(double real, Weight& value, std::false_type) {
+            if (std::isfinite(real) && std::fabs(real) > static_cast<double>(std::numeric_limits<Weight>::max()))
+                return false;
+            value = static_cast<Weight>(real);
+            return true;
+        }
+
+        /**
+         * Reads a weight, whole numbers without going through the C library.
+         * Numbers with a fraction or an exponent, or too long for 64 bits, are read with strtod.
+         * Fails for a number that doesn't fit a Weight.
+         */
+        inline bool parseWeight(const char*& p, const char* end, Weight& value) {
+            skipSpaces(p, end);
+            const char* start = p;
+            bool negative = p < end && *p == '-';
+            if (p < end && (*p == '-' || *p == '+'))
+                ++p;
+            const char* digits = p;
+            uint64_t whole = 0;
+            bool tooLong = false;
+            while (p < end && isDigit(*p)) {
+                uint64_t digit = static_cast<uint64_t>(*p - '0');
+                if (whole > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+                    tooLong = true;
+                else
+                    whole = whole * 10 + digit;
+                ++p;
+            }
+            if (tooLong || (p < end && (*p == '.' || *p == 'e' || *p == 'E'))) {
+                // strtod needs a terminated string, and the file is not one
+                const char* tokenEnd = p;
+                while (!atFieldEnd(tokenEnd, end))
+                    ++tokenEnd;
+                char token[64];
+                size_t length = static_cast<size_t>(tokenEnd - start);
+                if (length >= sizeof(token))
+                    return false;
+                std::memcpy(token, start, length);
+                token[length] = '\0';
+                char* parsedEnd = nullptr;
+                double real = std::strtod(token, &parsedEnd);
+                p = tokenEnd;
+                return parsedEnd == token + length && toWeight(real, value, std::is_integral<Weight>());
+            }
+            return p != digits && atFieldEnd(p, end) && toWeight(whole, negative, value, std::is_integral<Weight>());
+        }
+
+        /**
+         * Reads an edge line "u v [weight]", arcPrefix u v [weight] if arcPrefix isn't 0.
+         * @return False for a blank line, a comment (a line starting with # or %, or any line that
+         *         doesn't start with arcPrefix), true with the edge read into u, v and weight otherwise.
+         * @throws std::invalid_argument if the line is an edge line that can't be read.
+         */
+        inline bool parseEdgeLine(const char* line, const char* end, char arcPrefix,
+                                  size_t& u, size_t& v, Weight& weight) {
+            const char* p = line;
+            skipSpaces(p, end);
+            if (atLineEnd(p, end))
+                return false;
+            if (arcPrefix != 0) {
+                // comment and header lines
+                if (*p != arcPrefix)
+                    return false;
+                ++p;
+            } else if (*p == '#' || *p == '%') {
+                return false;
+            }
+
+            weight = 1;
+            if (!parseIndex(p, end, u) || !parseIndex(p, end, v))
+                throw lineError(line, end);
+            skipSpaces(p, end);
+            if (!atLineEnd(p, end) && !parseWeight(p, end, weight))
+                throw lineError(line, end);
+            skipSpaces(p, end);
+            if (!atLineEnd(p, end))
+                throw lineError(line, end);
+            return true;
+        }
+    }
+}
+
+#endif // TEXT_PARSING_HPP
@@ -0,0 +1,85 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef VARINT_HPP
+#define VARINT_HPP
+
+#include "GraphProperties.hpp"
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Variable length integers, 7 bits per byte with the high bit set on every byte but the last,
+ * so values below 128 take a single byte. Signed values are zigzag mapped first
+ * (0, -1, 1, -2, ... become 0, 1, 2, 3, ...) so small negative values stay short.
+ * Weights of an integral type are stored this way, floating point weights as their raw bytes.
+ */
+
+namespace ariel {
+    namespace varint {
+
+        inline void write(std::vector<uint8_t>& out, uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        inline uint64_t read(const uint8_t*& in) {
+            uint64_t value = *in++;
+            // most deltas fit in one byte, keep that path free of the loop
+            if (value < 0x80)
+                return value;
+            value &= 0x7F;
+            unsigned shift = 7;
+            uint8_t byte;
+            do {
+                byte = *in++;
+                value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte >= 0x80);
+            return value;
+        }
+
+        inline uint64_t zigzag(int64_t value) {
+            return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+        }
+
+        inline int64_t unzigzag(uint64_t value) {
+            return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+
+        inline void writeWeight(std::vector<uint8_t>& out, Weight weight, std::true_type) {
+            write(out, zigzag(static_cast<int64_t>(weight)));
+        }
+
+        inline void writeWeight(std::vector<uint8_t>& out, Weight weight, std::false_type) {
+            uint8_t raw[sizeof(Weight)];
+            std::memcpy(raw, &weight, sizeof(Weight));
+            out.insert(out.end(), raw, raw + sizeof(Weight));
+        }
+
+        inline void writeWeight(std::vector<uint8_t>& out, Weight weight) {
+            writeWeight(out, weight, std::is_integral<Weight>());
+        }
+
+        inline Weight readWeight(const uint8_t*& in, std::true_type) {
+            return static_cast<Weight>(unzigzag(read(in)));
+        }
+
+        inline Weight readWeight(const uint8_t*& in, std::false_type) {
+            Weight weight;
+            std::memcpy(&weight, in, sizeof(Weight));
+            in += sizeof(Weight);
+            return weight;
+        }
+
+        inline Weight readWeight(const uint8_t*& in) {
+            return readWeight(in, std::is_integral<Weight>());
+        }
+    }
+}
+
+#endif // VARINT_HPP
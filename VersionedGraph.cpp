@@ -0,0 +1,48 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "VersionedGraph.hpp"
+#include <utility>
+
+namespace ariel {
+
+    /**
+     * Publishes initial as version 0, moved to per-vertex edge vectors.
+     */
+    VersionedGraph::VersionedGraph(Graph initial) {
+        initial.makeEditable();
+        this->latest = std::make_shared<const Version>(0, std::move(initial));
+    }
+
+    /**
+     * The latest published version. Safe to call from any thread, and the graph stays valid and
+     * unchanged for as long as the snapshot (or a copy of its graph pointer) is held.
+     */
+    GraphSnapshot VersionedGraph::snapshot() const {
+        std::shared_ptr<const Version> current = std::atomic_load(&latest);
+        return GraphSnapshot{current->number, std::shared_ptr<const Graph>(current, &current->graph)};
+    }
+
+    size_t VersionedGraph::version() const {
+        return std::atomic_load(&latest)->number;
+    }
+
+    /**
+     * Applies change to a copy of the latest version and publishes the result as the next version.
+     * Writers are serialized, so no change is lost. The change should stick to edge and vertex
+     * updates: a change that moves the graph to another layout (reorder, compress) makes the next
+     * versions copy the whole graph.
+     * @param change Modifies the graph it is given.
+     * @return The number of the published version.
+     * @throws Whatever change throws, in which case nothing is published.
+     */
+    size_t VersionedGraph::update(const Change& change) {
+        std::lock_guard<std::mutex> lock(writers);
+        std::shared_ptr<const Version> current = std::atomic_load(&latest);
+        std::shared_ptr<Version> next = std::make_shared<Version>(current->number + 1, current->graph);
+        current.reset();
+        change(next->graph);
+        size_t number = next->number;
+        std::atomic_store(&latest, std::shared_ptr<const Version>(std::move(next)));
+        return number;
+    }
+}
@@ -0,0 +1,54 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef VERSIONED_GRAPH_HPP
+#define VERSIONED_GRAPH_HPP
+
+#include "Graph.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace ariel {
+
+    /**
+     * A published version of a VersionedGraph: its number and the graph, which never changes.
+     */
+    struct GraphSnapshot {
+        size_t version;
+        std::shared_ptr<const Graph> graph;
+    };
+
+    /**
+     * A graph that keeps serving queries while it is updated. Readers take a snapshot, an immutable
+     * graph they can run any algorithm on for as long as they hold it. Writers apply a change to a
+     * copy of the latest version and publish it as the next version in a single atomic store, so a
+     * reader never waits for a writer and never sees half of a change.
+     * The graph is kept as per-vertex edge vectors, which copies share copy-on-write, so publishing
+     * a version copies only the rows (and the blocks of row pointers) the change touched.
+     */
+    class VersionedGraph {
+    public:
+        typedef std::function<void(Graph&)> Change;
+
+        explicit VersionedGraph(Graph initial);
+
+        [[nodiscard]] GraphSnapshot snapshot() const;
+        [[nodiscard]] size_t version() const;
+        size_t update(const Change& change);
+
+    private:
+        struct Version {
+            Version(size_t number, Graph graph) : number(number), graph(std::move(graph)) {}
+            size_t number;
+            Graph graph;
+        };
+
+        // read and replaced with the atomic shared_ptr functions only
+        std::shared_ptr<const Version> latest;
+        // writers take turns, readers never take it
+        std::mutex writers;
+    };
+}
+
+#endif // VERSIONED_GRAPH_HPP
@@ -0,0 +1,119 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#include "VertexOrdering.hpp"
+#include <algorithm>
+#include <queue>
+
+namespace ariel {
+
+    /**
+     * Computes an order of the vertices of the graph.
+     * @param g The graph to order.
+     * @param order The kind of order, ORIGINAL gives the vertices back in their original numbering.
+     * @return The vertices of g in their new order.
+     */
+    std::vector<size_t> VertexOrdering::Execute(const Graph& g, VertexOrder order) {
+        switch (order) {
+            case VertexOrder::DEGREE:
+                return degreeOrder(g);
+            case VertexOrder::BFS:
+                return bfsOrder(g);
+            case VertexOrder::REVERSE_CUTHILL_MCKEE:
+                return reverseCuthillMcKee(g);
+            default: {
+                std::vector<size_t> original(g.V());
+                for (size_t i = 0; i < g.V(); ++i)
+                    original[i] = g.internalId(i);
+                return original;
+            }
+        }
+    }
+
+    /**
+     * Orders the vertices by decreasing degree, so the rows of the vertices with the most
+     * edges (which traversals reach most often) sit together at the start.
+     */
+    std::vector<size_t> VertexOrdering::degreeOrder(const Graph& g) {
+        std::vector<size_t> order(g.V());
+        for (size_t v = 0; v < g.V(); ++v)
+            order[v] = v;
+        std::stable_sort(order.begin(), order.end(), [&g](size_t a, size_t b) {
+            return g.outDegree(a) > g.outDegree(b);
+        });
+        return order;
+    }
+
+    /**
+     * Orders the vertices as a BFS from vertex 0 reaches them, starting again from the
+     * first unreached vertex until all of them are reached. Vertices a BFS visits one
+     * after the other end up next to each other.
+     */
+    std::vector<size_t> VertexOrdering::bfsOrder(const Graph& g) {
+        std::vector<size_t> order;
+        order.reserve(g.V());
+        std::vector<bool> visited(g.V(), false);
+
+        for (size_t start = 0; start < g.V(); ++start) {
+            if (visited[start])
+                continue;
+            visited[start] = true;
+            // the order itself is the queue of the BFS
+            size_t head = order.size();
+            order.push_back(start);
+            while (head < order.size()) {
+                size_t u = order[head++];
+                for (Neighbor edge : g.neighbors(u)) {
+                    if (!visited[edge.vertex]) {
+                        visited[edge.vertex] = true;
+                        order.push_back(edge.vertex);
+                    }
+                }
+            }
+        }
+        return order;
+    }
+
+    /**
+     * Reverse Cuthill-McKee: a BFS from a vertex of lowest degree of every component, visiting
+     * the neighbors of each vertex by increasing degree, then reversed. It keeps the edges
+     * close to the diagonal of the matrix (a small bandwidth), so the neighbors of a vertex
+     * are numbered close to it.
+     */
+    std::vector<size_t> VertexOrdering::reverseCuthillMcKee(const Graph& g) {
+        std::vector<size_t> byDegree(g.V());
+        for (size_t v = 0; v < g.V(); ++v)
+            byDegree[v] = v;
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&g](size_t a, size_t b) {
+            return g.outDegree(a) < g.outDegree(b);
+        });
+
+        std::vector<size_t> order;
+        order.reserve(g.V());
+        std::vector<bool> visited(g.V(), false);
+        std::vector<size_t> discovered;
+
+        for (size_t start : byDegree) {
+            if (visited[start])
+                continue;
+            visited[start] = true;
+            size_t head = order.size();
+            order.push_back(start);
+            while (head < order.size()) {
+                size_t u = order[head++];
+                discovered.clear();
+                for (Neighbor edge : g.neighbors(u)) {
+                    if (!visited[edge.vertex]) {
+                        visited[edge.vertex] = true;
+                        discovered.push_back(edge.vertex);
+                    }
+                }
+                std::stable_sort(discovered.begin(), discovered.end(), [&g](size_t a, size_t b) {
+                    return g.outDegree(a) < g.outDegree(b);
+                });
+                order.insert(order.end(), discovered.begin(), discovered.end());
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+}
@@ -0,0 +1,29 @@
+//written by Ido Avraham : 208699181
+//EMAIL: idoavraham086@gmail.com
+#ifndef VERTEX_ORDERING_HPP
+#define VERTEX_ORDERING_HPP
+
+#include "Graph.hpp"
+#include <vector>
+
+/**
+ * Orders of the vertices of a graph that keep vertices that are visited together close
+ * in memory once the graph is relabeled with Graph::reorder.
+ * Every order is returned as the list of the vertices in their new order, so the vertex
+ * at position i gets the number i. Degrees and neighbors are the outgoing ones, which for
+ * an undirected graph are all of them.
+ */
+
+namespace ariel {
+    class VertexOrdering {
+    public:
+        static std::vector<size_t> Execute(const Graph& g, VertexOrder order);
+
+    private:
+        static std::vector<size_t> degreeOrder(const Graph& g);
+        static std::vector<size_t> bfsOrder(const Graph& g);
+        static std::vector<size_t> reverseCuthillMcKee(const Graph& g);
+    };
+}
+
+#endif // VERTEX_ORDERING_HPP